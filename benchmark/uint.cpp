@@ -0,0 +1,156 @@
+// A microbenchmark of the uint operations used by the matching algorithm.
+// Build it with and without UINT_GENERIC_ARITHMETIC (see the Makefile) to
+// compare the specialized arithmetic with the generic piece-by-piece loops.
+// Both builds must print the same checksums.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <utility/uint.h>
+
+namespace
+{
+  constexpr std::size_t valueCount = 4096u;
+  constexpr std::size_t repetitions = 4096u;
+
+  template <std::size_t pieces>
+  using uint = utility::uinttypes::uint<pieces>;
+
+  template <std::size_t pieces>
+  std::uintmax_t fold(const uint<pieces> value)
+  {
+    std::uintmax_t result{ };
+    for (std::size_t piece{ }; piece < pieces; ++piece)
+    {
+      result ^=
+        (std::uintmax_t) (
+          value >> (unsigned int) (
+            piece * std::numeric_limits<std::uintmax_t>::digits));
+    }
+    return result;
+  }
+
+  template <std::size_t pieces>
+  std::vector<uint<pieces>> randomValues(std::mt19937_64 &engine)
+  {
+    std::vector<uint<pieces>> result;
+    for (std::size_t index{ }; index < valueCount; ++index)
+    {
+      uint<pieces> value;
+      for (std::size_t piece{ }; piece < pieces; ++piece)
+      {
+        value <<= std::numeric_limits<std::uintmax_t>::digits;
+        value |= uint<pieces>{ engine() };
+      }
+      // Leave room for the shifts used by the matching algorithm.
+      result.push_back(value >> 2u);
+    }
+    return result;
+  }
+
+  /**
+   * Apply operation to each pair of values, and print the time per call and a
+   * checksum of the results.
+   */
+  template <std::size_t pieces, typename Operation>
+  void measure(
+    const char *const name,
+    const std::vector<uint<pieces>> &values0,
+    const std::vector<uint<pieces>> &values1,
+    const Operation &operation)
+  {
+    std::uintmax_t checksum{ };
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t repetition{ }; repetition < repetitions; ++repetition)
+    {
+      for (std::size_t index{ }; index < valueCount; ++index)
+      {
+        checksum +=
+          operation(
+            values0[index],
+            values1[(index + repetition) % valueCount]);
+      }
+    }
+    const std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+    std::cout
+      << "uint<" << pieces << "> " << std::left << std::setw(12) << name
+      << std::right << std::fixed << std::setprecision(3) << std::setw(8)
+      << elapsed.count() / (valueCount * repetitions) << " ns/op"
+      << "  checksum " << std::hex << checksum << std::dec << '\n';
+  }
+
+  template <std::size_t pieces>
+  void measureAll(std::mt19937_64 &engine)
+  {
+    const std::vector<uint<pieces>> values0 = randomValues<pieces>(engine);
+    const std::vector<uint<pieces>> values1 = randomValues<pieces>(engine);
+    const std::vector<uint<pieces>> values2 = randomValues<pieces>(engine);
+
+    measure<pieces>(
+      "+=",
+      values0,
+      values1,
+      [](uint<pieces> value0, const uint<pieces> value1)
+      {
+        value0 += value1;
+        return fold(value0);
+      });
+    measure<pieces>(
+      "-=",
+      values0,
+      values1,
+      [](uint<pieces> value0, const uint<pieces> value1)
+      {
+        value0 -= value1;
+        return fold(value0);
+      });
+    measure<pieces>(
+      "<",
+      values0,
+      values1,
+      [](const uint<pieces> value0, const uint<pieces> value1)
+      {
+        return std::uintmax_t{ value0 < value1 };
+      });
+    measure<pieces>(
+      "<<= >>=",
+      values0,
+      values1,
+      [](uint<pieces> value0, const uint<pieces> value1)
+      {
+        const unsigned int shift = (unsigned int) value1 % 8u;
+        value0 <<= shift;
+        value0 >>= shift + 1u;
+        return fold(value0);
+      });
+    measure<pieces>(
+      "addSubtract",
+      values0,
+      values1,
+      [&values2](uint<pieces> value0, const uint<pieces> value1)
+      {
+        value0.addSubtract(value1, values2[(std::size_t) value1 % valueCount]);
+        return fold(value0);
+      });
+  }
+}
+
+int main()
+{
+#ifdef UINT_GENERIC_ARITHMETIC
+  std::cout << "Generic arithmetic\n";
+#else
+  std::cout << "Specialized arithmetic\n";
+#endif
+  std::mt19937_64 engine;
+  measureAll<2u>(engine);
+  measureAll<3u>(engine);
+  measureAll<4u>(engine);
+}
@@ -355,7 +355,7 @@ namespace fileformats
         {
           throw InvalidLineException();
         }
-        tournament::Player player(id, score, rating, std::move(matches));
+        tournament::Player player(id, score, rating);
         if (id >= tournament.players.size())
         {
           tournament.players.resize(id, tournament::Player());
@@ -371,6 +371,10 @@ namespace fileformats
             std::move(tournament.players[id].accelerations);
           tournament.players[id] = std::move(player);
         }
+        for (const tournament::Match &match : matches)
+        {
+          tournament.matchHistory.push_back(id, match);
+        }
         tournament.playersByRank.push_back(id);
         if (data)
         {
@@ -663,7 +667,8 @@ namespace fileformats
           {
             if (
               includesUnpairedRound
-                ^ (player.matches.size() > tournament.playedRounds))
+                ^ (tournament.matchHistory.getMatchCount(player.id)
+                    > tournament.playedRounds))
             {
               forwardRoundIsComplete = !includesUnpairedRound;
             }
@@ -673,13 +678,14 @@ namespace fileformats
         {
           ++tournament.playedRounds;
         }
-        for (tournament::Player &player : tournament.players)
+        for (const tournament::Player &player : tournament.players)
         {
-          if (player.isValid && player.matches.size() < tournament.playedRounds)
+          if (
+            player.isValid
+              && tournament.matchHistory.getMatchCount(player.id)
+                  < tournament.playedRounds)
           {
-            player.matches.resize(
-              tournament.playedRounds,
-              tournament::Match(player.id));
+            tournament.matchHistory.resize(player.id, tournament.playedRounds);
           }
         }
       }
@@ -763,18 +769,25 @@ namespace fileformats
       )
       {
         tournament::round_index minColorRound = ~tournament::round_index{ };
-        for (const tournament::Player &player : tournament.players)
+        for (
+          tournament::round_index roundIndex{ };
+          roundIndex < tournament.matchHistory.getRoundCount()
+            && minColorRound > roundIndex;
+          ++roundIndex)
         {
-          if (player.isValid)
+          for (
+            tournament::player_index playerIndex{ };
+            playerIndex < tournament.matchHistory.getPlayerCount();
+            ++playerIndex)
           {
-            tournament::round_index roundIndex{ };
-            for (const tournament::Match &match : player.matches)
+            if (
+              tournament.players[playerIndex].isValid
+                && tournament.matchHistory.getMatch(roundIndex, playerIndex)
+                      .color
+                    != tournament::COLOR_NONE)
             {
-              if (match.color != tournament::COLOR_NONE)
-              {
-                minColorRound = std::min(minColorRound, roundIndex);
-              }
-              ++roundIndex;
+              minColorRound = roundIndex;
+              break;
             }
           }
         }
@@ -785,11 +798,11 @@ namespace fileformats
         for (
           const tournament::player_index playerIndex : tournament.playersByRank)
         {
-          const tournament::Player &player = tournament.players[playerIndex];
-
           bool playerHadPairingNumberMinColorRound{ };
           tournament::round_index matchIndex{ };
-          for (const tournament::Match &match : player.matches)
+          for (
+            const tournament::Match &match
+              : tournament.matchHistory[playerIndex])
           {
             if (matchIndex > minColorRound)
             {
@@ -806,10 +819,12 @@ namespace fileformats
           {
             if (result == tournament::COLOR_NONE)
             {
+              const tournament::Color color =
+                tournament.matchHistory[playerIndex][minColorRound].color;
               result =
                 effectivePairingNumberMinColorRound & 1u
-                  ? invert(player.matches[minColorRound].color)
-                  : player.matches[minColorRound].color;
+                  ? invert(color)
+                  : color;
             }
             ++effectivePairingNumberMinColorRound;
           }
@@ -829,17 +844,21 @@ namespace fileformats
           if (player.isValid)
           {
             tournament::round_index matchIndex{ };
-            for (const tournament::Match &match : player.matches)
+            for (
+              const tournament::Match &match
+                : tournament.matchHistory[player.id])
             {
               if (match.gameWasPlayed)
               {
                 const tournament::Player &opponent =
                   tournament.players[match.opponent];
+                const tournament::Match opponentMatch =
+                  tournament.matchHistory[match.opponent][matchIndex];
                 if (
                   !opponent.isValid
-                    || !opponent.matches[matchIndex].gameWasPlayed
-                    || opponent.matches[matchIndex].color == match.color
-                    || opponent.matches[matchIndex].opponent != player.id)
+                    || !opponentMatch.gameWasPlayed
+                    || opponentMatch.color == match.color
+                    || opponentMatch.opponent != player.id)
                 {
                   throw FileFormatException(
                     "Match "
@@ -877,7 +896,9 @@ namespace fileformats
             }
             tournament::points points{ };
             tournament::round_index matchIndex{ };
-            for (const tournament::Match &match : player.matches)
+            for (
+              const tournament::Match &match
+                : tournament.matchHistory[player.id])
             {
               if (matchIndex >= tournament.playedRounds)
               {
@@ -912,11 +933,16 @@ namespace fileformats
             }
             if (player.scoreWithoutAcceleration != points)
             {
-              if (player.matches.size() > tournament.playedRounds)
+              if (
+                tournament.matchHistory.getMatchCount(player.id)
+                  > tournament.playedRounds)
               {
                 tournament::points nextRoundPoints =
-                  tournament
-                    .getPoints(player, player.matches[tournament.playedRounds]);
+                  tournament.getPoints(
+                    player,
+                    tournament.matchHistory
+                      [player.id]
+                      [tournament.playedRounds]);
                 if (player.scoreWithoutAcceleration >= nextRoundPoints)
                 {
                   player.scoreWithoutAcceleration -= nextRoundPoints;
@@ -950,7 +976,8 @@ namespace fileformats
        */
       std::string stringifyGames(
         const tournament::Player &player,
-        const tournament::player_index rank)
+        const tournament::player_index rank,
+        const tournament::Tournament &tournament)
       {
         if (player.scoreWithoutAcceleration > 999u)
         {
@@ -965,7 +992,8 @@ namespace fileformats
           << std::setw(5)
           << utility::uintstringconversion::toString(rank + 1u);
 
-        for (const tournament::Match &match : player.matches)
+        for (
+          const tournament::Match &match : tournament.matchHistory[player.id])
         {
           outputStream << "  ";
 
@@ -1325,10 +1353,13 @@ namespace fileformats
           if (pair.first != result.playedRounds)
             continue;
 
-          auto &player = result.players[pair.second];
-          if (player.matches.size() <= result.playedRounds)
+          if (
+            result.matchHistory.getMatchCount(pair.second)
+              <= result.playedRounds)
           {
-            player.matches.emplace_back(player.id);
+            result.matchHistory.push_back(
+              pair.second,
+              tournament::Match(pair.second));
           }
         }
       }
@@ -1400,7 +1431,7 @@ namespace fileformats
           << utility::uintstringconversion::toString(player.rating)
           << std::setw(28)
           << ""
-          << stringifyGames(player, ranks[player.id]);
+          << stringifyGames(player, ranks[player.id], tournament);
 
         outputStream << '\r';
       }
@@ -1521,7 +1552,10 @@ namespace fileformats
           80,
           std::u32string::npos,
           convert.from_bytes(
-            stringifyGames(tournament.players[playerIndex], ranks[playerIndex]))
+            stringifyGames(
+              tournament.players[playerIndex],
+              ranks[playerIndex],
+              tournament))
         );
       }
 
@@ -538,7 +538,7 @@ int main(const int argc, char**const argv)
         try
         {
           pairs =
-            info.computeMatching(std::move(tournament), checklistStream.get());
+            info.computeMatching(tournament, checklistStream.get());
         }
         catch (const swisssystems::NoValidPairingException &exception)
         {
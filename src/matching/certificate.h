@@ -0,0 +1,262 @@
+#ifndef MATCHINGCERTIFICATE_H
+#define MATCHINGCERTIFICATE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <limits>
+#include <vector>
+
+#include "detail/types.h"
+
+namespace matching
+{
+  /**
+   * An optimal solution to the dual of the maximum weight matching linear
+   * program, as computed by a Computer. It proves that a matching has maximum
+   * weight, and verifyDualCertificate checks that proof without rerunning the
+   * matching algorithm.
+   *
+   * The dual variables are in units of half an edge weight, so the slack of
+   * the edge between u and v is
+   * vertexDualVariables[u] + vertexDualVariables[v] - 2 * weight(u, v), plus
+   * the dual variables of the blossoms containing both u and v.
+   */
+  template <typename edge_weight>
+  struct DualCertificate
+  {
+    struct Blossom
+    {
+      /**
+       * The range of vertexOrder holding the vertices of the blossom.
+       */
+      std::size_t begin;
+      std::size_t end;
+      edge_weight dualVariable;
+    };
+
+    /**
+     * The dual variables of the vertices, indexed by vertex index.
+     */
+    std::vector<edge_weight> vertexDualVariables;
+    /**
+     * The vertex indices, ordered so that the vertices of each blossom are
+     * contiguous.
+     */
+    std::vector<detail::vertex_index> vertexOrder;
+    /**
+     * The blossoms with more than one vertex, ordered by begin, and by
+     * decreasing end among those with the same begin. This puts each blossom
+     * after the blossoms containing it.
+     */
+    std::vector<Blossom> blossoms;
+  };
+
+  namespace detail
+  {
+    /**
+     * Compare addend0 + addend1 + *addend2 to target without overflow,
+     * returning a value less than, equal to, or greater than zero as the sum
+     * is. A null addend2 counts as zero.
+     */
+    template <typename edge_weight>
+    int compareSum(
+      edge_weight target,
+      const edge_weight &addend0,
+      const edge_weight &addend1,
+      const edge_weight *const addend2)
+    {
+      for (const edge_weight *addend : { &addend0, &addend1, addend2 })
+      {
+        if (!addend)
+        {
+          continue;
+        }
+        if (target < *addend)
+        {
+          return 1;
+        }
+        target -= *addend;
+      }
+      return target ? -1 : 0;
+    }
+  }
+
+  /**
+   * Check that certificate proves matching to have maximum weight, in time
+   * O(n^2). matching is in the format returned by Computer::getMatching(), and
+   * edgeWeights(u, v) must return the weight of the edge between u and v, as
+   * passed to the Computer.
+   *
+   * The conditions checked are that every slack is nonnegative, that every
+   * matched edge has slack zero and nonzero weight, that every unmatched vertex
+   * has dual variable zero, and that every blossom with nonzero dual variable
+   * contains as many matched edges as possible.
+   */
+  template <typename edge_weight, class EdgeWeights>
+  bool verifyDualCertificate(
+    const DualCertificate<edge_weight> &certificate,
+    const std::vector<detail::vertex_index> &matching,
+    const EdgeWeights &edgeWeights)
+  {
+    constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    const std::size_t size = certificate.vertexDualVariables.size();
+    if (matching.size() != size || certificate.vertexOrder.size() != size)
+    {
+      return false;
+    }
+
+    std::vector<std::size_t> positions(size, npos);
+    for (std::size_t position{ }; position < size; ++position)
+    {
+      const detail::vertex_index vertex = certificate.vertexOrder[position];
+      if (vertex >= size || positions[vertex] != npos)
+      {
+        return false;
+      }
+      positions[vertex] = position;
+    }
+    for (std::size_t vertex{ }; vertex < size; ++vertex)
+    {
+      const detail::vertex_index match = matching[vertex];
+      if (match >= size || matching[match] != vertex)
+      {
+        return false;
+      }
+      if (match == vertex && certificate.vertexDualVariables[vertex])
+      {
+        return false;
+      }
+    }
+
+    // Check that the blossoms are nested, and find the sum of the dual
+    // variables of each blossom and its ancestors.
+    const std::size_t blossomCount = certificate.blossoms.size();
+    std::vector<std::size_t> parents(blossomCount, npos);
+    std::vector<edge_weight> ancestorDualVariables;
+    ancestorDualVariables.reserve(blossomCount);
+    std::vector<std::size_t> innermostBlossoms(size, npos);
+    {
+      std::vector<std::size_t> openBlossoms;
+      for (std::size_t index{ }; index < blossomCount; ++index)
+      {
+        const typename DualCertificate<edge_weight>::Blossom &blossom =
+          certificate.blossoms[index];
+        if (
+          blossom.end > size
+            || blossom.end - blossom.begin < 3u
+            || blossom.end - blossom.begin > size
+            || !((blossom.end - blossom.begin) & 1u))
+        {
+          return false;
+        }
+        while (
+          !openBlossoms.empty()
+            && certificate.blossoms[openBlossoms.back()].end <= blossom.begin)
+        {
+          openBlossoms.pop_back();
+        }
+        ancestorDualVariables.push_back(blossom.dualVariable);
+        if (!openBlossoms.empty())
+        {
+          const typename DualCertificate<edge_weight>::Blossom &parent =
+            certificate.blossoms[openBlossoms.back()];
+          if (blossom.begin < parent.begin || blossom.end > parent.end)
+          {
+            return false;
+          }
+          parents[index] = openBlossoms.back();
+          ancestorDualVariables.back() += ancestorDualVariables[parents[index]];
+          if (ancestorDualVariables.back() < blossom.dualVariable)
+          {
+            return false;
+          }
+        }
+        openBlossoms.push_back(index);
+        for (
+          std::size_t position = blossom.begin;
+          position < blossom.end;
+          ++position)
+        {
+          innermostBlossoms[position] = index;
+        }
+
+        if (blossom.dualVariable)
+        {
+          std::size_t matchedVertices{ };
+          for (
+            std::size_t position = blossom.begin;
+            position < blossom.end;
+            ++position)
+          {
+            const detail::vertex_index vertex =
+              certificate.vertexOrder[position];
+            const std::size_t matchPosition = positions[matching[vertex]];
+            matchedVertices +=
+              matchPosition != position
+                && matchPosition >= blossom.begin
+                && matchPosition < blossom.end;
+          }
+          if (matchedVertices + 1u != blossom.end - blossom.begin)
+          {
+            return false;
+          }
+        }
+      }
+    }
+
+    // For each vertex, find the sum of the dual variables of the blossoms
+    // containing it and each later vertex, and check the slacks of the edges
+    // between them.
+    std::vector<const edge_weight *> sharedDualVariables(size);
+    for (std::size_t position{ }; position < size; ++position)
+    {
+      std::fill(
+        sharedDualVariables.begin(),
+        sharedDualVariables.end(),
+        nullptr);
+      std::size_t childEnd = position + 1u;
+      for (
+        std::size_t index = innermostBlossoms[position];
+        index != npos;
+        index = parents[index])
+      {
+        std::fill(
+          sharedDualVariables.begin() + childEnd,
+          sharedDualVariables.begin() + certificate.blossoms[index].end,
+          &ancestorDualVariables[index]);
+        childEnd = certificate.blossoms[index].end;
+      }
+
+      const detail::vertex_index vertex = certificate.vertexOrder[position];
+      const edge_weight &dualVariable =
+        certificate.vertexDualVariables[vertex];
+      for (
+        std::size_t neighborPosition = position + 1u;
+        neighborPosition < size;
+        ++neighborPosition)
+      {
+        const detail::vertex_index neighbor =
+          certificate.vertexOrder[neighborPosition];
+        const edge_weight edgeWeight{ edgeWeights(vertex, neighbor) };
+        const int comparison =
+          detail::compareSum(
+            edgeWeight << 1,
+            dualVariable,
+            certificate.vertexDualVariables[neighbor],
+            sharedDualVariables[neighborPosition]);
+        if (
+          comparison < 0
+            || (matching[vertex] == neighbor
+                  && (comparison || !edgeWeight)))
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+}
+
+#endif
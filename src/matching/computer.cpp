@@ -1,5 +1,8 @@
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <limits>
+#include <utility>
 #include <vector>
 
 #include "computer.h"
@@ -10,6 +13,10 @@
 #include "detail/types.h"
 #include "detail/verteximpl.h"
 
+#ifndef MATCHING_THREADS
+#define MATCHING_THREADS 1
+#endif
+
 namespace matching
 {
   namespace
@@ -19,13 +26,30 @@ namespace matching
 
   /**
    * Construct a new maximum matching computer that supports at most the
-   * specified number of nodes and at most the specified edge weight.
+   * specified number of nodes and at most the specified edge weight. It uses
+   * the number of threads set by the build (see the matching_threads flag in
+   * the Makefile).
    */
   template <typename edge_weight>
   Computer<edge_weight>::Computer(
       const Computer<edge_weight>::size_type capacity,
       const edge_weight &maxEdgeWeight)
-    : graph(new Graph<edge_weight>(capacity, maxEdgeWeight)) { }
+    : graph(new Graph<edge_weight>(capacity, maxEdgeWeight))
+  {
+    setThreadCount(MATCHING_THREADS);
+  }
+  /**
+   * Take over the graph of another Computer, including its dual variables,
+   * blossoms, and matching. The moved-from Computer may only be destroyed or
+   * assigned to.
+   */
+  template <typename edge_weight>
+  Computer<edge_weight>::Computer(Computer<edge_weight> &&that) noexcept
+    = default;
+  template <typename edge_weight>
+  Computer<edge_weight> &Computer<edge_weight>::operator=(
+    Computer<edge_weight> &&that
+  ) & noexcept = default;
   template <typename edge_weight>
   Computer<edge_weight>::~Computer() noexcept = default;
 
@@ -47,20 +71,118 @@ namespace matching
     assert(graph->size() <= std::numeric_limits<vertex_index>::max());
     assert(graph->size() < graph->capacity());
 
-    for (
-      auto iterator = graph->rootBlossomPool.begin();
-      iterator != graph->rootBlossomPool.end();
-      ++iterator)
+    // The new Vertex's row and column of the edge weight matrix are still
+    // zero, because weights are only set between existing Vertexes. Likewise,
+    // the RootBlossom minOuterEdges rows already have room for it.
+    graph->emplace_back(graph->size(), *graph);
+  }
+
+  /**
+   * Start from the matching and dual variables of previous, a Computer over
+   * mostly the same vertices, for example the one for the previous round of a
+   * tournament. Vertex i stands for vertex previousVertices[i] of previous, or
+   * is new if previousVertices[i] is not less than previous.size(), so the
+   * vertices can be reordered, dropped and added.
+   *
+   * The weights of the edges between retained vertices are copied. The
+   * blossoms of previous are dissolved, with half of each blossom's dual
+   * variable added to the dual variables of its vertices, which keeps every
+   * resistance nonnegative. The matched pairs among the retained vertices are
+   * kept if their edge is still tight, which it is unless a blossom containing
+   * only one of them had a nonzero dual variable. Setting the weights of only
+   * the vertices whose edges have changed (see getEdgeWeight) then lets the
+   * next computeMatching() call repair only those vertices and the pairs that
+   * were not kept.
+   *
+   * This Computer must have previousVertices.size() vertices, no edges of
+   * nonzero weight, and the same maximum edge weight as previous. The matching
+   * of previous must be computed, as getMatching() requires.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::warmStart(
+    const Computer<edge_weight> &previous,
+    const std::vector<vertex_index> &previousVertices) &
+  {
+    assert(previousVertices.size() == graph->size());
+    assert(!graph->nonzeroEdgeCount);
+    assert(graph->aboveMaxEdgeWeight == previous.graph->aboveMaxEdgeWeight);
+
+    const Graph<edge_weight> &previousGraph = *previous.graph;
+    const std::vector<vertex_index> previousMatching = previous.getMatching();
+    std::vector<vertex_index> vertices(
+      previousGraph.size(),
+      std::numeric_limits<vertex_index>::max());
+    for (vertex_index vertex{ }; vertex < graph->size(); ++vertex)
     {
-      iterator->minOuterEdges.emplace_back();
+      if (previousVertices[vertex] < previousGraph.size())
+      {
+        assert(
+          vertices[previousVertices[vertex]]
+            == std::numeric_limits<vertex_index>::max());
+        vertices[previousVertices[vertex]] = vertex;
+      }
     }
-    graph->emplace_back(graph->size(), *graph);
-    for (Vertex<edge_weight> &vertex : *graph) {
-      if (&vertex != &graph->back())
+
+    for (vertex_index vertex{ }; vertex < graph->size(); ++vertex)
+    {
+      if (previousVertices[vertex] >= previousGraph.size())
+      {
+        continue;
+      }
+      const Vertex<edge_weight> &previousVertex =
+        previousGraph[previousVertices[vertex]];
+      for (vertex_index neighbor{ }; neighbor < vertex; ++neighbor)
+      {
+        if (previousVertices[neighbor] < previousGraph.size())
+        {
+          const edge_weight edgeWeight{
+            previousVertex.edgeWeights[previousVertices[neighbor]]
+          };
+          if (edgeWeight)
+          {
+            writeEdgeWeight(vertex, neighbor, edgeWeight >> 1);
+          }
+        }
+      }
+
+      edge_weight dualVariable{ previousVertex.dualVariable };
+      for (
+        const ParentBlossom<edge_weight> *blossom =
+          previousVertex.parentBlossom;
+        blossom;
+        blossom = blossom->parentBlossom)
       {
-        vertex.edgeWeights.push_back(graph->aboveMaxEdgeWeight & 0u);
+        assert(!(blossom->dualVariable & 1u));
+        dualVariable += blossom->dualVariable >> 1;
+      }
+      (*graph)[vertex].dualVariable = dualVariable;
+    }
+
+    for (vertex_index vertex{ }; vertex < graph->size(); ++vertex)
+    {
+      if (previousVertices[vertex] >= previousGraph.size())
+      {
+        continue;
+      }
+      const vertex_index match = previousMatching[previousVertices[vertex]];
+      if (
+        match == previousVertices[vertex]
+          || vertices[match] == std::numeric_limits<vertex_index>::max())
+      {
+        continue;
+      }
+      Vertex<edge_weight> &matchVertex = (*graph)[vertices[match]];
+      const edge_weight dualVariable{ (*graph)[vertex].dualVariable };
+      const edge_weight matchDualVariable{ matchVertex.dualVariable };
+      if (
+        !compareSum<edge_weight>(
+          edge_weight{ (*graph)[vertex].edgeWeights[matchVertex.vertexIndex] },
+          dualVariable,
+          matchDualVariable,
+          nullptr))
+      {
+        (*graph)[vertex].rootBlossom->baseVertexMatch = &matchVertex;
       }
-      graph->back().edgeWeights.push_back(graph->aboveMaxEdgeWeight & 0u);
     }
   }
 
@@ -78,6 +200,396 @@ namespace matching
     const vertex_index modifiedVertex,
     const vertex_index neighbor,
     edge_weight edgeWeight) &
+  {
+    prepareVertexForWeightAdjustments(modifiedVertex);
+    writeEdgeWeight(modifiedVertex, neighbor, std::move(edgeWeight));
+  }
+
+  /**
+   * Set the weight of the edge between modifiedVertex and neighbors[i] to
+   * edgeWeights[i], for each i less than edgeWeights.size(). This has the same
+   * effect as the corresponding setEdgeWeight calls, but modifiedVertex is
+   * only disconnected from its blossom and match once.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::setEdgeWeights(
+    const vertex_index modifiedVertex,
+    const std::vector<vertex_index> &neighbors,
+    const std::vector<edge_weight> &edgeWeights) &
+  {
+    assert(neighbors.size() >= edgeWeights.size());
+
+    if (edgeWeights.empty())
+    {
+      return;
+    }
+    prepareVertexForWeightAdjustments(modifiedVertex);
+    auto neighborIterator = neighbors.begin();
+    for (const edge_weight &edgeWeight : edgeWeights)
+    {
+      writeEdgeWeight(modifiedVertex, *neighborIterator, edgeWeight);
+      ++neighborIterator;
+    }
+  }
+
+  /**
+   * Apply the updates. This has the same effect as the corresponding
+   * setEdgeWeight calls, but each distinct modifiedVertex is only disconnected
+   * from its blossom and match once.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::setEdgeWeights(
+    const std::vector<EdgeWeightUpdate> &updates) &
+  {
+    std::vector<bool> prepared(graph->size());
+    for (const EdgeWeightUpdate &update : updates)
+    {
+      assert(update.modifiedVertex < graph->size());
+      if (!prepared[update.modifiedVertex])
+      {
+        prepareVertexForWeightAdjustments(update.modifiedVertex);
+        prepared[update.modifiedVertex] = true;
+      }
+    }
+    for (const EdgeWeightUpdate &update : updates)
+    {
+      writeEdgeWeight(
+        update.modifiedVertex,
+        update.neighbor,
+        update.edgeWeight);
+    }
+  }
+
+  /**
+   * Set the weights as setEdgeWeights does, but only if the current dual
+   * variables prove that the matching stays optimal, and that none of the
+   * changed edges is in any maximum weight matching. In that case nothing is
+   * disconnected, so the matching remains valid without another
+   * computeMatching() call. Return whether the weights were set.
+   *
+   * This must be called right after computeMatching(). It only accepts
+   * changes to edges joining different RootBlossoms whose resistance is
+   * positive both before and after the change.
+   */
+  template <typename edge_weight>
+  bool Computer<edge_weight>::setEdgeWeightsIfOptimal(
+    const vertex_index modifiedVertex,
+    const std::vector<vertex_index> &neighbors,
+    const std::vector<edge_weight> &edgeWeights) &
+  {
+    assert(neighbors.size() >= edgeWeights.size());
+    assert(modifiedVertex < graph->size());
+
+    const Vertex<edge_weight> &vertex = (*graph)[modifiedVertex];
+    const edge_weight dualVariable{ vertex.dualVariable };
+    auto neighborIterator = neighbors.begin();
+    for (const edge_weight &edgeWeight : edgeWeights)
+    {
+      assert(*neighborIterator < graph->size());
+      const Vertex<edge_weight> &neighbor = (*graph)[*neighborIterator];
+      ++neighborIterator;
+      const edge_weight currentEdgeWeight{
+        vertex.edgeWeights[neighbor.vertexIndex]
+      };
+      if (currentEdgeWeight == edgeWeight << 1)
+      {
+        continue;
+      }
+      const edge_weight neighborDualVariable{ neighbor.dualVariable };
+      if (
+        vertex.rootBlossom == neighbor.rootBlossom
+          || compareSum<edge_weight>(
+                currentEdgeWeight,
+                dualVariable,
+                neighborDualVariable,
+                nullptr)
+              <= 0
+          || compareSum<edge_weight>(
+                edgeWeight << 1,
+                dualVariable,
+                neighborDualVariable,
+                nullptr)
+              <= 0)
+      {
+        return false;
+      }
+    }
+
+    neighborIterator = neighbors.begin();
+    for (const edge_weight &edgeWeight : edgeWeights)
+    {
+      if (
+        edge_weight{ vertex.edgeWeights[*neighborIterator] }
+          != edgeWeight << 1)
+      {
+        writeEdgeWeight(modifiedVertex, *neighborIterator, edgeWeight);
+      }
+      ++neighborIterator;
+    }
+    return true;
+  }
+
+  /**
+   * Set the weights as setEdgeWeights does, but only if the dual variables
+   * prove that every maximum weight matching under the new weights pairs
+   * modifiedVertex with its current match. The two vertices are matched
+   * between different RootBlossoms, whose Blossoms are disassembled so that
+   * the dual variables of the two can be chosen afresh: the matched edge must
+   * stay tight, the other edges at the match must keep nonnegative
+   * resistance, and the other edges at modifiedVertex must get positive
+   * resistance. Nothing is disconnected, so no computeMatching() call is
+   * needed. Return whether the weights were set; otherwise nothing changes.
+   *
+   * This must be called right after computeMatching(), or after calls to
+   * this function or isolateMatchedPair that followed it and succeeded.
+   */
+  template <typename edge_weight>
+  bool Computer<edge_weight>::setEdgeWeightsIfMatchIsForced(
+    const vertex_index modifiedVertex,
+    const std::vector<vertex_index> &neighbors,
+    const std::vector<edge_weight> &edgeWeights) &
+  {
+    assert(neighbors.size() >= edgeWeights.size());
+    assert(modifiedVertex < graph->size());
+
+    Vertex<edge_weight> &vertex = (*graph)[modifiedVertex];
+    if (
+      vertex.rootBlossom->baseVertex != &vertex
+        || !vertex.rootBlossom->baseVertexMatch)
+    {
+      return false;
+    }
+    Vertex<edge_weight> &match = *vertex.rootBlossom->baseVertexMatch;
+    assert(match.rootBlossom->baseVertex == &match);
+
+    std::vector<edge_weight> newEdgeWeights;
+    newEdgeWeights.reserve(graph->size());
+    for (vertex_index neighbor{ }; neighbor < graph->size(); ++neighbor)
+    {
+      newEdgeWeights.push_back(edge_weight{ vertex.edgeWeights[neighbor] });
+    }
+    auto neighborIterator = neighbors.begin();
+    for (const edge_weight &edgeWeight : edgeWeights)
+    {
+      assert(*neighborIterator < graph->size());
+      newEdgeWeights[*neighborIterator] = edgeWeight << 1;
+      ++neighborIterator;
+    }
+    const edge_weight &matchedEdgeWeight = newEdgeWeights[match.vertexIndex];
+    if (!matchedEdgeWeight)
+    {
+      return false;
+    }
+
+    // Find the dual variables of the other vertices once the Blossoms
+    // containing the two vertices are disassembled, as in freeAncestorOfBase.
+    std::vector<edge_weight> dualVariables;
+    dualVariables.reserve(graph->size());
+    for (const Vertex<edge_weight> &neighbor : *graph)
+    {
+      dualVariables.push_back(edge_weight{ neighbor.dualVariable });
+    }
+    for (const Vertex<edge_weight> *const base : { &vertex, &match })
+    {
+      edge_weight dualVariableAdjustment = graph->aboveMaxEdgeWeight & 0u;
+      for (
+        const ParentBlossom<edge_weight> *blossom = base->parentBlossom;
+        blossom;
+        blossom = blossom->parentBlossom)
+      {
+        dualVariableAdjustment += blossom->dualVariable >> 1;
+      }
+      const Blossom<edge_weight> *child = base;
+      for (
+        const ParentBlossom<edge_weight> *blossom = base->parentBlossom;
+        blossom;
+        blossom = blossom->parentBlossom)
+      {
+        for (
+          const Vertex<edge_weight> *neighbor = blossom->vertexListHead;
+          ;
+          neighbor = neighbor->nextVertex)
+        {
+          if (neighbor == child->vertexListHead)
+          {
+            neighbor = child->vertexListTail;
+          }
+          else
+          {
+            dualVariables[neighbor->vertexIndex] += dualVariableAdjustment;
+          }
+          if (neighbor == blossom->vertexListTail)
+          {
+            break;
+          }
+        }
+        dualVariableAdjustment -= blossom->dualVariable >> 1;
+        child = blossom;
+      }
+    }
+
+    // Find the range of dual variables for modifiedVertex that satisfies the
+    // conditions, with the dual variable of the match making up the rest of
+    // the matched edge weight.
+    const edge_weight maxDualVariable = graph->aboveMaxEdgeWeight >> 1;
+    edge_weight minVertexDualVariable = graph->aboveMaxEdgeWeight & 0u;
+    ++minVertexDualVariable;
+    if (matchedEdgeWeight > maxDualVariable)
+    {
+      minVertexDualVariable =
+        std::max(
+          minVertexDualVariable,
+          edge_weight{ matchedEdgeWeight - maxDualVariable });
+    }
+    edge_weight minMatchDualVariable = graph->aboveMaxEdgeWeight & 0u;
+    for (vertex_index neighbor{ }; neighbor < graph->size(); ++neighbor)
+    {
+      if (neighbor == modifiedVertex || neighbor == match.vertexIndex)
+      {
+        continue;
+      }
+      const edge_weight &neighborDualVariable = dualVariables[neighbor];
+      edge_weight bound = newEdgeWeights[neighbor];
+      if (bound)
+      {
+        ++bound;
+        if (bound > neighborDualVariable)
+        {
+          bound -= neighborDualVariable;
+          minVertexDualVariable = std::max(minVertexDualVariable, bound);
+        }
+      }
+      bound = edge_weight{ match.edgeWeights[neighbor] };
+      if (bound > neighborDualVariable)
+      {
+        bound -= neighborDualVariable;
+        minMatchDualVariable = std::max(minMatchDualVariable, bound);
+      }
+    }
+    if (
+      minVertexDualVariable > maxDualVariable
+        || minVertexDualVariable > matchedEdgeWeight
+        || minMatchDualVariable > matchedEdgeWeight - minVertexDualVariable)
+    {
+      return false;
+    }
+
+    vertex.rootBlossom->freeAncestorOfBase(vertex, *graph);
+    match.rootBlossom->freeAncestorOfBase(match, *graph);
+    neighborIterator = neighbors.begin();
+    for (const edge_weight &edgeWeight : edgeWeights)
+    {
+      if (
+        edge_weight{ vertex.edgeWeights[*neighborIterator] }
+          != edgeWeight << 1)
+      {
+        writeEdgeWeight(modifiedVertex, *neighborIterator, edgeWeight);
+      }
+      ++neighborIterator;
+    }
+    vertex.dualVariable = minVertexDualVariable;
+    match.dualVariable = matchedEdgeWeight - minVertexDualVariable;
+    putVerticesInMatchingOrder();
+    return true;
+  }
+
+  /**
+   * If the two vertices are matched to each other, and are in different
+   * RootBlossoms, give the edge between them the specified nonzero weight and
+   * their other edges weight zero, as finalizePair does, but keep them
+   * matched. The Blossoms containing them are disassembled, and their dual
+   * variables lowered to suit, so the matching stays optimal and the next
+   * computeMatching() call need not repair the pair. Return whether this was
+   * done; otherwise nothing changes.
+   *
+   * This has the same precondition as setEdgeWeightsIfMatchIsForced.
+   */
+  template <typename edge_weight>
+  bool Computer<edge_weight>::isolateMatchedPair(
+    const vertex_index vertexIndex0,
+    const vertex_index vertexIndex1,
+    edge_weight edgeWeight) &
+  {
+    assert(vertexIndex0 < graph->size());
+    assert(vertexIndex1 < graph->size());
+
+    Vertex<edge_weight> &vertex0 = (*graph)[vertexIndex0];
+    Vertex<edge_weight> &vertex1 = (*graph)[vertexIndex1];
+    if (
+      !edgeWeight
+        || vertex0.rootBlossom->baseVertex != &vertex0
+        || vertex0.rootBlossom->baseVertexMatch != &vertex1)
+    {
+      return false;
+    }
+    assert(vertex1.rootBlossom->baseVertex == &vertex1);
+
+    // This only raises the resistances of edges leaving the Blossoms, and
+    // the edge between the vertices is given new dual variables below.
+    vertex0.rootBlossom->freeAncestorOfBase(vertex0, *graph);
+    vertex1.rootBlossom->freeAncestorOfBase(vertex1, *graph);
+
+    for (vertex_index neighbor{ }; neighbor < graph->size(); ++neighbor)
+    {
+      if (neighbor != vertexIndex0 && neighbor != vertexIndex1)
+      {
+        writeEdgeWeight(vertexIndex0, neighbor, edgeWeight & 0u);
+        writeEdgeWeight(vertexIndex1, neighbor, edgeWeight & 0u);
+      }
+    }
+
+    // Only the edge between the vertices remains, so it is enough to make it
+    // tight with even dual variables.
+    edge_weight dualVariable0 = edgeWeight << 1;
+    edge_weight dualVariable1 = edgeWeight & 0u;
+    writeEdgeWeight(vertexIndex0, vertexIndex1, std::move(edgeWeight));
+    vertex0.dualVariable = dualVariable0;
+    vertex1.dualVariable = dualVariable1;
+    putVerticesInMatchingOrder();
+    return true;
+  }
+
+  /**
+   * Return the weight of the edge between the two vertices, as last set.
+   */
+  template <typename edge_weight>
+  edge_weight Computer<edge_weight>::getEdgeWeight(
+    const vertex_index vertex,
+    const vertex_index neighbor
+  ) const
+  {
+    assert(vertex != neighbor);
+    assert(vertex < graph->size());
+    assert(neighbor < graph->size());
+
+    return edge_weight{ (*graph)[vertex].edgeWeights[neighbor] } >> 1;
+  }
+
+  /**
+   * Disconnect the vertex from its blossom and its match, and raise its dual
+   * variable, so that the weights of its edges can be changed without making
+   * any resistance negative.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::prepareVertexForWeightAdjustments(
+    const vertex_index modifiedVertex) &
+  {
+    assert(modifiedVertex < graph->size());
+
+    (*graph)[modifiedVertex]
+      .rootBlossom
+      ->prepareVertexForWeightAdjustments((*graph)[modifiedVertex], *graph);
+  }
+
+  /**
+   * Store the weight of the edge, assuming modifiedVertex has been prepared
+   * for weight adjustments.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::writeEdgeWeight(
+    const vertex_index modifiedVertex,
+    const vertex_index neighbor,
+    edge_weight edgeWeight) &
   {
     assert(modifiedVertex != neighbor);
     assert(modifiedVertex < graph->size());
@@ -85,18 +597,56 @@ namespace matching
     assert((graph->aboveMaxEdgeWeight - 1u) >> 2 >= edgeWeight);
     assert(edgeWeight << 2 < graph->aboveMaxEdgeWeight);
 
+    if ((*graph)[modifiedVertex].edgeWeights[neighbor])
+    {
+      --graph->nonzeroEdgeCount;
+    }
+    if (edgeWeight)
+    {
+      ++graph->nonzeroEdgeCount;
+    }
     edgeWeight <<= 1;
-    (*graph)[modifiedVertex]
-      .rootBlossom
-      ->prepareVertexForWeightAdjustments((*graph)[modifiedVertex], *graph);
     (*graph)[modifiedVertex].edgeWeights[neighbor] = edgeWeight;
     (*graph)[neighbor].edgeWeights[modifiedVertex] = std::move(edgeWeight);
+    (*graph)[modifiedVertex].neighborsStale = true;
+    (*graph)[neighbor].neighborsStale = true;
+  }
+
+  /**
+   * Return the number of edges of nonzero weight, so that callers can decide
+   * whether to filter the outer-outer scans of computeMatching().
+   */
+  template <typename edge_weight>
+  std::size_t Computer<edge_weight>::getNonzeroEdgeCount() const
+  {
+    return graph->nonzeroEdgeCount;
+  }
+
+  /**
+   * Compute the maximum weight matching. If filterOuterOuterScans is set, the
+   * scans for the minimum outer-outer edges only visit the edges of nonzero
+   * weight, using neighbor lists rebuilt for the vertices whose weights
+   * changed. This produces the same matching, and is faster when most edges
+   * have weight zero, for example when most pairings are forbidden. The edge
+   * weights are still stored in the full matrix, so the lists add to the
+   * memory used rather than replacing it.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::computeMatching(
+    const bool filterOuterOuterScans
+  ) const &
+  {
+    graph->computeMatching(filterOuterOuterScans);
+    putVerticesInMatchingOrder();
   }
 
+  /**
+   * Order the vertex lists of the RootBlossoms so that getMatching() can read
+   * the matching from them, after the matching or the Blossoms change.
+   */
   template <typename edge_weight>
-  void Computer<edge_weight>::computeMatching() const &
+  void Computer<edge_weight>::putVerticesInMatchingOrder() const &
   {
-    graph->computeMatching();
     for (
       auto rootBlossomIterator = graph->rootBlossomPool.begin();
       rootBlossomIterator != graph->rootBlossomPool.end();
@@ -104,6 +654,36 @@ namespace matching
     {
       rootBlossomIterator->putVerticesInMatchingOrder();
     }
+
+    assert(
+      verifyDualCertificate(
+        getDualCertificate(),
+        getMatching(),
+        [this](const vertex_index vertex, const vertex_index neighbor)
+        {
+          return getEdgeWeight(vertex, neighbor);
+        }));
+  }
+
+  /**
+   * Split the edge scans and dual variable adjustments of later
+   * computeMatching() calls across threadCount threads, including the calling
+   * thread. The matching computed does not depend on the number of threads.
+   */
+  template <typename edge_weight>
+  void Computer<edge_weight>::setThreadCount(const std::size_t threadCount) &
+  {
+    graph->setThreadCount(threadCount);
+  }
+
+  /**
+   * Return the work done by all the computeMatching() calls so far. The
+   * counters are only gathered by builds defining MATCHING_STATS.
+   */
+  template <typename edge_weight>
+  const Stats &Computer<edge_weight>::getStats() const
+  {
+    return graph->stats;
   }
 
   /**
@@ -163,6 +743,80 @@ namespace matching
     return result;
   }
 
+  /**
+   * Return the dual variables and blossoms proving that the matching returned
+   * by getMatching() has maximum weight (see verifyDualCertificate).
+   *
+   * computeMatching() must be called before this if any update operations have
+   * been performed.
+   */
+  template <typename edge_weight>
+  auto Computer<edge_weight>::getDualCertificate() const
+    -> DualCertificate<edge_weight>
+  {
+    DualCertificate<edge_weight> result;
+    result.vertexDualVariables.reserve(graph->size());
+    for (vertex_index vertex{ }; vertex < graph->size(); ++vertex)
+    {
+      result.vertexDualVariables.emplace_back((*graph)[vertex].dualVariable);
+    }
+
+    // The vertex list of each RootBlossom has the vertices of each of its
+    // descendants contiguous, starting at the descendant's vertexListHead and
+    // ending at its vertexListTail.
+    result.vertexOrder.reserve(graph->size());
+    std::vector<std::size_t> openBlossoms;
+    for (
+      auto rootBlossomIterator = graph->rootBlossomPool.begin();
+      rootBlossomIterator != graph->rootBlossomPool.end();
+      ++rootBlossomIterator)
+    {
+      for (
+        auto vertexIterator = rootBlossomIterator->rootChild.vertexListHead;
+        vertexIterator;
+        vertexIterator = vertexIterator->nextVertex)
+      {
+        const std::size_t position = result.vertexOrder.size();
+        const std::size_t firstNewBlossom = result.blossoms.size();
+        for (
+          const ParentBlossom<edge_weight> *parentBlossom =
+            vertexIterator->parentBlossom;
+          parentBlossom && parentBlossom->vertexListHead == vertexIterator;
+          parentBlossom = parentBlossom->parentBlossom)
+        {
+          result.blossoms.push_back(
+            { position, position, parentBlossom->dualVariable });
+        }
+        // Put the outermost of the new blossoms first.
+        std::reverse(
+          result.blossoms.begin() + firstNewBlossom,
+          result.blossoms.end());
+        for (
+          std::size_t index = firstNewBlossom;
+          index < result.blossoms.size();
+          ++index)
+        {
+          openBlossoms.push_back(index);
+        }
+
+        result.vertexOrder.push_back(vertexIterator->vertexIndex);
+
+        for (
+          const ParentBlossom<edge_weight> *parentBlossom =
+            vertexIterator->parentBlossom;
+          parentBlossom && parentBlossom->vertexListTail == vertexIterator;
+          parentBlossom = parentBlossom->parentBlossom)
+        {
+          assert(!openBlossoms.empty());
+          result.blossoms[openBlossoms.back()].end = position + 1u;
+          openBlossoms.pop_back();
+        }
+      }
+      assert(openBlossoms.empty());
+    }
+    return result;
+  }
+
 #define COMPUTER_INSTANTIATION(a) template class Computer<a>;
     INSTANTIATE_MATCHING_EDGE_WEIGHT_TEMPLATES(COMPUTER_INSTANTIATION)
 }
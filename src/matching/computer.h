@@ -1,12 +1,16 @@
 #ifndef COMPUTER_H
 #define COMPUTER_H
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
 
 #include <utility/uinttypes.h>
 
+#include "certificate.h"
+#include "stats.h"
+
 #include "detail/graphsig.h"
 #include "detail/types.h"
 
@@ -23,6 +27,10 @@ namespace matching
    *
    * The graph is considered to be complete. Edges that are not present have
    * weight zero, and the algorithm never includes such edges in the matching.
+   *
+   * A new Computer can also start from the matching and dual variables of a
+   * solved one over mostly the same vertices (see warmStart), so that only the
+   * vertices whose edges changed are repaired.
    */
   template <typename edge_weight_>
   class Computer
@@ -33,6 +41,8 @@ namespace matching
     Computer(size_type, const edge_weight_ &);
     ~Computer() noexcept;
     Computer(Computer &) = delete;
+    Computer(Computer &&) noexcept;
+    Computer &operator=(Computer &&) & noexcept;
 
     typedef detail::vertex_index vertex_index;
     /**
@@ -44,14 +54,50 @@ namespace matching
     size_type size() const;
 
     void addVertex() &;
+    void warmStart(const Computer &, const std::vector<vertex_index> &) &;
+    /**
+     * A change to the weight of the edge between modifiedVertex and neighbor.
+     */
+    struct EdgeWeightUpdate
+    {
+      vertex_index modifiedVertex;
+      vertex_index neighbor;
+      edge_weight edgeWeight;
+    };
+
     void setEdgeWeight(vertex_index, vertex_index, edge_weight) &;
+    void setEdgeWeights(
+      vertex_index,
+      const std::vector<vertex_index> &,
+      const std::vector<edge_weight> &) &;
+    void setEdgeWeights(const std::vector<EdgeWeightUpdate> &) &;
+    bool setEdgeWeightsIfOptimal(
+      vertex_index,
+      const std::vector<vertex_index> &,
+      const std::vector<edge_weight> &) &;
+    bool setEdgeWeightsIfMatchIsForced(
+      vertex_index,
+      const std::vector<vertex_index> &,
+      const std::vector<edge_weight> &) &;
+    bool isolateMatchedPair(vertex_index, vertex_index, edge_weight) &;
+    edge_weight getEdgeWeight(vertex_index, vertex_index) const;
+
+    std::size_t getNonzeroEdgeCount() const;
 
-    void computeMatching() const &;
+    void computeMatching(bool filterOuterOuterScans = false) const &;
+    void setThreadCount(std::size_t) &;
 
     std::vector<vertex_index> getMatching() const;
+    DualCertificate<edge_weight> getDualCertificate() const;
+
+    const Stats &getStats() const;
 
   private:
-    const std::unique_ptr<detail::Graph<edge_weight>> graph;
+    std::unique_ptr<detail::Graph<edge_weight>> graph;
+
+    void prepareVertexForWeightAdjustments(vertex_index) &;
+    void putVerticesInMatchingOrder() const &;
+    void writeEdgeWeight(vertex_index, vertex_index, edge_weight) &;
   };
 
   namespace
@@ -1,16 +1,21 @@
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <deque>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
+#include <utility/threadpool.h>
+
 #include "../templateinstantiation.h"
 
 #include "blossomsig.h"
 #include "graphsig.h"
 #include "parentblossomsig.h"
+#include "resistance.h"
 #include "rootblossomimpl.h"
 #include "types.h"
 #include "verteximpl.h"
@@ -21,6 +26,12 @@ namespace matching
   {
     namespace
     {
+      /**
+       * The fewest Vertexes worth handing to a separate thread. The scans of
+       * smaller Graphs run on the calling thread.
+       */
+      constexpr std::size_t minVerticesPerThread = 256u;
+
       /**
        * If the provided outer Vertex has a lower dual variable than the current
        * minimum, update the minimum.
@@ -40,64 +51,91 @@ namespace matching
       }
 
       /**
-       * If the provided outer RootBlossom has a lower minOuterEdgeResistance
-       * than the current minimum, update the minimum.
+       * Return a vector indicating, for each vertexIndex, whether the Vertex
+       * is in a non-OUTER RootBlossom.
        */
       template <typename edge_weight>
-      void updateMinOuterOuterEdgeResistance(
-        RootBlossom<edge_weight> &newRootBlossom,
-        RootBlossom<edge_weight> *&minOuterOuterEdgeResistanceRootBlossom,
-        edge_weight &minOuterOuterEdgeResistance)
+      std::vector<unsigned char> getNonOuterVertices(
+        const Graph<edge_weight> &graph)
       {
-        if (newRootBlossom.minOuterEdgeResistance < minOuterOuterEdgeResistance)
+        std::vector<unsigned char> result;
+        result.reserve(graph.size());
+        for (const Vertex<edge_weight> &vertex : graph)
         {
-          minOuterOuterEdgeResistance =
-            newRootBlossom.minOuterEdgeResistance;
-          minOuterOuterEdgeResistanceRootBlossom = &newRootBlossom;
+          result.push_back(vertex.rootBlossom->label != LABEL_OUTER);
         }
-        assert(
-          !minOuterOuterEdgeResistanceRootBlossom
-            || !(minOuterOuterEdgeResistance & 1u));
+        return result;
       }
 
       /**
-       * If the provided inner RootBlossom has a lower blossom dual variable
-       * than the minimum, update the minimum.
+       * Return a vector containing, for each vertexIndex of a Vertex in an
+       * OUTER RootBlossom, the position of the Vertex in the RootBlossom's
+       * list of Vertexes.
        */
       template <typename edge_weight>
-      void updateMinInnerDualVariable(
-        RootBlossom<edge_weight> &newRootBlossom,
-        ParentBlossom<edge_weight> *&minInnerDualVariableBlossom,
-        edge_weight &minInnerDualVariable)
+      std::vector<vertex_index> getOuterVertexPositions(
+        const Graph<edge_weight> &graph)
       {
-        if (!newRootBlossom.rootChild.isVertex)
+        std::vector<vertex_index> result(graph.size());
+        for (
+          auto rootBlossomIterator = graph.rootBlossomPool.begin();
+          rootBlossomIterator != graph.rootBlossomPool.end();
+          ++rootBlossomIterator)
         {
-          ParentBlossom<edge_weight> &parentBlossom =
-            static_cast<ParentBlossom<edge_weight> &>(newRootBlossom.rootChild);
-          if (parentBlossom.dualVariable < minInnerDualVariable)
+          if (rootBlossomIterator->label == LABEL_OUTER)
           {
-            minInnerDualVariable = parentBlossom.dualVariable;
-            minInnerDualVariableBlossom = &parentBlossom;
+            vertex_index position{ };
+            for (
+              const Vertex<edge_weight> *vertexIterator =
+                rootBlossomIterator->rootChild.vertexListHead;
+              vertexIterator;
+              vertexIterator = vertexIterator->nextVertex)
+            {
+              result[vertexIterator->vertexIndex] = position++;
+            }
           }
         }
-        assert(!minInnerDualVariableBlossom || !(minInnerDualVariable & 1u));
+        return result;
       }
 
       /**
-       * If the resistance between the two Vertexes is smaller than the min
-       * stored in innerVertex, update the min.
+       * For each Vertex flagged in nonOuterVertices with vertexIndex in
+       * [begin, end), if the resistance between it and outerVertex is smaller
+       * than the min it stores, update the min.
+       *
+       * The resistances are computed by streaming over outerVertex's row of
+       * edge weights, rather than by visiting the Vertexes one at a time.
+       * improved is scratch space of the same size as nonOuterVertices.
        */
       template <typename edge_weight>
-      void updateInnerOuterEdge(
-        Vertex<edge_weight> &innerVertex,
+      void updateInnerOuterEdges(
+        Graph<edge_weight> &graph,
         Vertex<edge_weight> &outerVertex,
-        edge_weight &resistanceStorage)
+        const std::vector<unsigned char> &nonOuterVertices,
+        std::vector<unsigned char> &improved,
+        const typename Graph<edge_weight>::size_type begin,
+        const typename Graph<edge_weight>::size_type end)
       {
-        outerVertex.resistance(resistanceStorage, innerVertex);
-        if (resistanceStorage < innerVertex.minOuterEdgeResistance)
+        assert(nonOuterVertices.size() == graph.size());
+        assert(improved.size() == graph.size());
+        edge_weight_traits<edge_weight>::updateMinResistances(
+          outerVertex.dualVariable,
+          graph.vertexDualVariables,
+          outerVertex.edgeWeights,
+          graph.vertexMinOuterEdgeResistances,
+          begin,
+          end,
+          nonOuterVertices.data(),
+          improved.data());
+        for (
+          typename Graph<edge_weight>::size_type index = begin;
+          index < end;
+          ++index)
         {
-          innerVertex.minOuterEdgeResistance = resistanceStorage;
-          innerVertex.minOuterEdge = &outerVertex;
+          if (improved[index])
+          {
+            graph[index].minOuterEdge = &outerVertex;
+          }
         }
       }
     }
@@ -181,6 +219,83 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
     INSTANTIATE_MATCHING_EDGE_WEIGHT_TEMPLATES(
       UPDATE_OUTER_OUTER_EDGES_INSTANTIATION)
 
+    /**
+     * The number of ranges forEachVertexRange should split the Vertexes into:
+     * one per thread, unless the Graph is too small for that to pay off.
+     */
+    template <typename edge_weight>
+    typename Graph<edge_weight>::size_type
+      Graph<edge_weight>::getVertexRangeCount() const &
+    {
+      if (!threadPool)
+      {
+        return 1u;
+      }
+      return
+        std::max(
+          typename Graph<edge_weight>::size_type{ 1u },
+          std::min(
+            typename Graph<edge_weight>::size_type{ threadPool->size() },
+            this->size() / minVerticesPerThread));
+    }
+
+    /**
+     * Split the vertexIndexes into rangeCount consecutive ranges, and call
+     * function(range, begin, end) for each, on the threadPool if there is
+     * more than one. Each range begins at a multiple of resistance::blockSize,
+     * so that the ranges do not share blocks of the edge_weight vectors. Some
+     * ranges may be empty.
+     */
+    template <typename edge_weight>
+    template <class Function>
+    void Graph<edge_weight>::forEachVertexRange(
+      const typename Graph<edge_weight>::size_type rangeCount,
+      const Function &function
+    ) &
+    {
+      if (rangeCount <= 1u)
+      {
+        function(0u, 0u, this->size());
+        return;
+      }
+      const typename Graph<edge_weight>::size_type rangeSize =
+        ((this->size() + rangeCount - 1u) / rangeCount
+            + resistance::blockSize - 1u)
+          / resistance::blockSize
+          * resistance::blockSize;
+      threadPool->run(
+        rangeCount,
+        [this, &function, rangeSize](
+          const std::size_t range,
+          const std::size_t)
+        {
+          const typename Graph<edge_weight>::size_type begin =
+            std::min(range * rangeSize, this->size());
+          function(range, begin, std::min(begin + rangeSize, this->size()));
+        });
+    }
+
+    /**
+     * Return the OUTER RootBlossoms, in the order of rootBlossomPool.
+     */
+    template <typename edge_weight>
+    std::vector<RootBlossom<edge_weight> *>
+      Graph<edge_weight>::getOuterRootBlossoms() const &
+    {
+      std::vector<RootBlossom<edge_weight> *> result;
+      for (
+        auto rootBlossomIterator = rootBlossomPool.begin();
+        rootBlossomIterator != rootBlossomPool.end();
+        ++rootBlossomIterator)
+      {
+        if (rootBlossomIterator->label == LABEL_OUTER)
+        {
+          result.push_back(&*rootBlossomIterator);
+        }
+      }
+      return result;
+    }
+
     /**
      * Set the label member of all the RootBlossoms, and set labeledVertex and
      * labelingVertex to 0.
@@ -211,23 +326,32 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
       const RootBlossom<edge_weight> &outerBlossom
     ) &
     {
-      edge_weight resistance = aboveMaxEdgeWeight;
-      for (Vertex<edge_weight> &innerVertex : *this)
-      {
-        if (innerVertex.rootBlossom->label != LABEL_OUTER)
+      MATCHING_STATS_COUNT(stats, innerOuterEdgeUpdates);
+      MATCHING_STATS_TIME(stats, innerOuterEdgeUpdateNanoseconds);
+      const std::vector<unsigned char> nonOuterVertices =
+        getNonOuterVertices(*this);
+      std::vector<unsigned char> improved(this->size());
+      forEachVertexRange(
+        getVertexRangeCount(),
+        [this, &outerBlossom, &nonOuterVertices, &improved](
+          const typename Graph<edge_weight>::size_type,
+          const typename Graph<edge_weight>::size_type begin,
+          const typename Graph<edge_weight>::size_type end)
         {
           for (
             auto outerVertexIterator = outerBlossom.rootChild.vertexListHead;
             outerVertexIterator;
             outerVertexIterator = outerVertexIterator->nextVertex)
           {
-            updateInnerOuterEdge(
-              innerVertex,
+            detail::updateInnerOuterEdges(
+              *this,
               *outerVertexIterator,
-              resistance);
+              nonOuterVertices,
+              improved,
+              begin,
+              end);
           }
-        }
-      }
+        });
     }
 
     /**
@@ -237,28 +361,40 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
     template <typename edge_weight>
     void Graph<edge_weight>::initializeInnerOuterEdges() &
     {
-      std::vector<Vertex<edge_weight> *> outerVertices;
-      outerVertices.reserve(this->size());
-      for (Vertex<edge_weight> &outerVertex : *this)
-      {
-        if (outerVertex.rootBlossom->label == LABEL_OUTER)
-        {
-          outerVertices.push_back(&outerVertex);
-        }
-      }
-      edge_weight resistance = aboveMaxEdgeWeight;
-      for (Vertex<edge_weight> &innerVertex : *this)
-      {
-        if (innerVertex.rootBlossom->label != LABEL_OUTER)
+      const std::vector<unsigned char> nonOuterVertices =
+        getNonOuterVertices(*this);
+      std::vector<unsigned char> improved(this->size());
+      forEachVertexRange(
+        getVertexRangeCount(),
+        [this, &nonOuterVertices, &improved](
+          const typename Graph<edge_weight>::size_type,
+          const typename Graph<edge_weight>::size_type begin,
+          const typename Graph<edge_weight>::size_type end)
         {
-          innerVertex.minOuterEdgeResistance = aboveMaxEdgeWeight;
-
-          for (Vertex<edge_weight> *outerVertex : outerVertices)
+          for (
+            typename Graph<edge_weight>::size_type index = begin;
+            index < end;
+            ++index)
+          {
+            if (nonOuterVertices[index])
+            {
+              (*this)[index].minOuterEdgeResistance = aboveMaxEdgeWeight;
+            }
+          }
+          for (Vertex<edge_weight> &outerVertex : *this)
           {
-            updateInnerOuterEdge(innerVertex, *outerVertex, resistance);
+            if (!nonOuterVertices[outerVertex.vertexIndex])
+            {
+              detail::updateInnerOuterEdges(
+                *this,
+                outerVertex,
+                nonOuterVertices,
+                improved,
+                begin,
+                end);
+            }
           }
-        }
-      }
+        });
     }
 
     /**
@@ -270,7 +406,7 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
       RootBlossom<edge_weight> &blossom0,
       edge_weight &resistanceStorage0,
       edge_weight &resistanceStorage1
-    ) const &
+    ) &
     {
       blossom0.minOuterEdgeResistance = aboveMaxEdgeWeight;
       for (
@@ -300,15 +436,396 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
               resistanceStorage0,
               resistanceStorage1);
           }
+          outerRootBlossomHeap.update(*iterator);
+        }
+      }
+    }
+    /**
+     * The same as the unfiltered version, but only visiting the edges of
+     * nonzero weight, using the Vertex neighbors lists. Edges of weight zero
+     * never become tight before an OUTER dual variable reaches zero, so they
+     * do not affect the computation.
+     *
+     * The min edges chosen are the same as in the unfiltered version, which
+     * visits the Vertexes of the other RootBlossom in list order, and keeps the
+     * first of several edges with equal resistance. outerVertexPositions
+     * gives the list positions, as computed by getOuterVertexPositions. A
+     * pair of RootBlossoms with no edges of nonzero weight between them is
+     * left with null min edges.
+     */
+    template <typename edge_weight>
+    void Graph<edge_weight>::initializeFilteredOuterOuterEdges(
+      RootBlossom<edge_weight> &blossom0,
+      const std::vector<vertex_index> &outerVertexPositions,
+      edge_weight &resistanceStorage
+    ) &
+    {
+      blossom0.minOuterEdgeResistance = aboveMaxEdgeWeight;
+      for (
+        auto iterator = rootBlossomPool.begin();
+        iterator != rootBlossomPool.end();
+        ++iterator)
+      {
+        if (iterator->label == LABEL_OUTER && &blossom0 != &*iterator)
+        {
+          blossom0.minOuterEdges[iterator->baseVertex->vertexIndex] =
+            nullptr;
+          iterator->minOuterEdges[blossom0.baseVertex->vertexIndex] = nullptr;
+          rootBlossomPairResistances[rootBlossomPool.getIndex(*iterator)] =
+            aboveMaxEdgeWeight;
+        }
+      }
+
+      for (
+        Vertex<edge_weight> *vertexIterator0 =
+          blossom0.rootChild.vertexListHead;
+        vertexIterator0;
+        vertexIterator0 = vertexIterator0->nextVertex)
+      {
+        for (const vertex_index neighborIndex : vertexIterator0->neighbors)
+        {
+          Vertex<edge_weight> &vertex1 = (*this)[neighborIndex];
+          RootBlossom<edge_weight> &blossom1 = *vertex1.rootBlossom;
+          if (blossom1.label != LABEL_OUTER || &blossom1 == &blossom0)
+          {
+            continue;
+          }
+
+          vertexIterator0->resistance(resistanceStorage, vertex1);
+
+          assert(!(resistanceStorage & 1u));
+
+          auto &&minResistance =
+            rootBlossomPairResistances[rootBlossomPool.getIndex(blossom1)];
+          Vertex<edge_weight> *&minVertex0 =
+            blossom0.minOuterEdges[blossom1.baseVertex->vertexIndex];
+          Vertex<edge_weight> *&minVertex1 =
+            blossom1.minOuterEdges[blossom0.baseVertex->vertexIndex];
+          if (
+            resistanceStorage < minResistance
+              || (minVertex0 == vertexIterator0
+                    && !(minResistance < resistanceStorage)
+                    && outerVertexPositions[vertex1.vertexIndex]
+                        < outerVertexPositions[minVertex1->vertexIndex]))
+          {
+            minResistance = resistanceStorage;
+            minVertex0 = vertexIterator0;
+            minVertex1 = &vertex1;
+
+            if (resistanceStorage < blossom0.minOuterEdgeResistance)
+            {
+              blossom0.minOuterEdgeResistance = resistanceStorage;
+            }
+            if (resistanceStorage < blossom1.minOuterEdgeResistance)
+            {
+              blossom1.minOuterEdgeResistance = resistanceStorage;
+              outerRootBlossomHeap.update(blossom1);
+            }
+          }
         }
       }
     }
+
+    /**
+     * The same as initializeOuterOuterEdges(blossom0, ...) in the dense
+     * version, but scanning the other OUTER RootBlossoms in parallel.
+     * outerBlossoms are the OUTER RootBlossoms, in the order of
+     * rootBlossomPool.
+     *
+     * The RootBlossom minOuterEdgeResistances and the heap are updated after
+     * the scans, in the order the serial version updates them.
+     */
+    template <typename edge_weight>
+    void Graph<edge_weight>::initializeOuterOuterEdgesInParallel(
+      RootBlossom<edge_weight> &blossom0,
+      const std::vector<RootBlossom<edge_weight> *> &outerBlossoms
+    ) &
+    {
+      threadPool->run(
+        outerBlossoms.size(),
+        [this, &blossom0, &outerBlossoms](
+          const std::size_t task,
+          const std::size_t)
+        {
+          RootBlossom<edge_weight> &blossom1 = *outerBlossoms[task];
+          if (&blossom1 == &blossom0)
+          {
+            return;
+          }
+          edge_weight resistance = aboveMaxEdgeWeight;
+          edge_weight minResistance = aboveMaxEdgeWeight;
+          Vertex<edge_weight> *minVertex0{ };
+          Vertex<edge_weight> *minVertex1{ };
+          for (
+            Vertex<edge_weight> *vertexIterator0 =
+              blossom0.rootChild.vertexListHead;
+            vertexIterator0;
+            vertexIterator0 = vertexIterator0->nextVertex)
+          {
+            for (
+              Vertex<edge_weight> *vertexIterator1 =
+                blossom1.rootChild.vertexListHead;
+              vertexIterator1;
+              vertexIterator1 = vertexIterator1->nextVertex)
+            {
+              vertexIterator0->resistance(resistance, *vertexIterator1);
+
+              assert(!(resistance & 1u));
+
+              if (resistance < minResistance)
+              {
+                minResistance = resistance;
+                minVertex0 = vertexIterator0;
+                minVertex1 = vertexIterator1;
+              }
+            }
+          }
+          blossom0.minOuterEdges[blossom1.baseVertex->vertexIndex] =
+            minVertex0;
+          blossom1.minOuterEdges[blossom0.baseVertex->vertexIndex] =
+            minVertex1;
+          rootBlossomPairResistances[rootBlossomPool.getIndex(blossom1)] =
+            minResistance;
+        });
+
+      blossom0.minOuterEdgeResistance = aboveMaxEdgeWeight;
+      for (RootBlossom<edge_weight> *const blossom1 : outerBlossoms)
+      {
+        if (blossom1 != &blossom0)
+        {
+          auto &&minResistance =
+            rootBlossomPairResistances[rootBlossomPool.getIndex(*blossom1)];
+          if (minResistance < blossom0.minOuterEdgeResistance)
+          {
+            blossom0.minOuterEdgeResistance = minResistance;
+          }
+          if (minResistance < blossom1->minOuterEdgeResistance)
+          {
+            blossom1->minOuterEdgeResistance = minResistance;
+          }
+          outerRootBlossomHeap.update(*blossom1);
+        }
+      }
+    }
+
+    /**
+     * The same as initializeOuterOuterEdges() in the dense version, but with
+     * a task for each OUTER RootBlossom. outerBlossoms are the OUTER
+     * RootBlossoms, in the order of rootBlossomPool.
+     *
+     * The serial version scans each pair of RootBlossoms twice, and keeps the
+     * min edge found by the scan of the later RootBlossom in rootBlossomPool,
+     * which visits that RootBlossom's Vertexes in the outer loop. Each task
+     * repeats that scan for each pair involving its RootBlossom, but only
+     * writes its own side of the result, so the tasks share no outputs.
+     */
+    template <typename edge_weight>
+    void Graph<edge_weight>::initializeOuterOuterEdgesInParallel(
+      const std::vector<RootBlossom<edge_weight> *> &outerBlossoms
+    ) &
+    {
+      threadPool->run(
+        outerBlossoms.size(),
+        [this, &outerBlossoms](const std::size_t task, const std::size_t)
+        {
+          RootBlossom<edge_weight> &blossom0 = *outerBlossoms[task];
+          edge_weight resistance = aboveMaxEdgeWeight;
+          edge_weight pairResistance = aboveMaxEdgeWeight;
+          edge_weight minResistance = aboveMaxEdgeWeight;
+          for (std::size_t index{ }; index < outerBlossoms.size(); ++index)
+          {
+            if (index == task)
+            {
+              continue;
+            }
+            RootBlossom<edge_weight> &blossom1 = *outerBlossoms[index];
+            const bool blossom0IsLater = task > index;
+            const RootBlossom<edge_weight> &laterBlossom =
+              blossom0IsLater ? blossom0 : blossom1;
+            const RootBlossom<edge_weight> &earlierBlossom =
+              blossom0IsLater ? blossom1 : blossom0;
+
+            pairResistance = aboveMaxEdgeWeight;
+            Vertex<edge_weight> *minVertex{ };
+            for (
+              Vertex<edge_weight> *vertexIterator0 =
+                laterBlossom.rootChild.vertexListHead;
+              vertexIterator0;
+              vertexIterator0 = vertexIterator0->nextVertex)
+            {
+              for (
+                Vertex<edge_weight> *vertexIterator1 =
+                  earlierBlossom.rootChild.vertexListHead;
+                vertexIterator1;
+                vertexIterator1 = vertexIterator1->nextVertex)
+              {
+                vertexIterator0->resistance(resistance, *vertexIterator1);
+
+                assert(!(resistance & 1u));
+
+                if (resistance < pairResistance)
+                {
+                  pairResistance = resistance;
+                  minVertex =
+                    blossom0IsLater ? vertexIterator0 : vertexIterator1;
+                }
+              }
+            }
+            blossom0.minOuterEdges[blossom1.baseVertex->vertexIndex] =
+              minVertex;
+            if (pairResistance < minResistance)
+            {
+              minResistance = pairResistance;
+            }
+          }
+          blossom0.minOuterEdgeResistance = minResistance;
+        });
+    }
+
+    /**
+     * The same as initializeOuterOuterEdges() in the filtered version, but
+     * with a task for each OUTER RootBlossom, as in the unfiltered parallel
+     * version.
+     *
+     * The serial version keeps, for each pair of RootBlossoms, the min edge
+     * found by initializeFilteredOuterOuterEdges for the later RootBlossom in
+     * rootBlossomPool. Of the edges of minimum resistance, that is the first
+     * in the order of the later RootBlossom's Vertexes, then the earlier
+     * RootBlossom's Vertexes. Each task scans the edges of its own Vertexes,
+     * and applies that order directly.
+     */
+    template <typename edge_weight>
+    void Graph<edge_weight>::initializeFilteredOuterOuterEdgesInParallel(
+      const std::vector<RootBlossom<edge_weight> *> &outerBlossoms
+    ) &
+    {
+      const std::vector<vertex_index> outerVertexPositions =
+        getOuterVertexPositions(*this);
+      std::vector<std::size_t> outerBlossomRanks(vertexCapacity + 1u);
+      for (std::size_t rank{ }; rank < outerBlossoms.size(); ++rank)
+      {
+        outerBlossomRanks[rootBlossomPool.getIndex(*outerBlossoms[rank])] =
+          rank;
+      }
+
+      /**
+       * Whether the edge between laterVertex and earlierVertex comes before
+       * the edge between minLaterVertex and minEarlierVertex.
+       */
+      const auto precedes =
+        [&outerVertexPositions](
+          const Vertex<edge_weight> &laterVertex,
+          const Vertex<edge_weight> &earlierVertex,
+          const Vertex<edge_weight> &minLaterVertex,
+          const Vertex<edge_weight> &minEarlierVertex)
+        {
+          const vertex_index laterPosition =
+            outerVertexPositions[laterVertex.vertexIndex];
+          const vertex_index minLaterPosition =
+            outerVertexPositions[minLaterVertex.vertexIndex];
+          return
+            laterPosition < minLaterPosition
+              || (laterPosition == minLaterPosition
+                    && outerVertexPositions[earlierVertex.vertexIndex]
+                        < outerVertexPositions[minEarlierVertex.vertexIndex]);
+        };
+
+      threadPool->run(
+        outerBlossoms.size(),
+        [this, &outerBlossoms, &outerBlossomRanks, &precedes](
+          const std::size_t task,
+          const std::size_t thread)
+        {
+          FilteredScanScratch &scratch = filteredScanScratch[thread];
+          RootBlossom<edge_weight> &blossom0 = *outerBlossoms[task];
+          for (RootBlossom<edge_weight> *const blossom1 : outerBlossoms)
+          {
+            if (blossom1 != &blossom0)
+            {
+              const auto blossom1Index = rootBlossomPool.getIndex(*blossom1);
+              blossom0.minOuterEdges[blossom1->baseVertex->vertexIndex] =
+                nullptr;
+              scratch.pairResistances[blossom1Index] = aboveMaxEdgeWeight;
+              scratch.pairVertices[blossom1Index] = nullptr;
+            }
+          }
+
+          edge_weight minResistance = aboveMaxEdgeWeight;
+          for (
+            Vertex<edge_weight> *vertexIterator0 =
+              blossom0.rootChild.vertexListHead;
+            vertexIterator0;
+            vertexIterator0 = vertexIterator0->nextVertex)
+          {
+            for (const vertex_index neighborIndex : vertexIterator0->neighbors)
+            {
+              Vertex<edge_weight> &vertex1 = (*this)[neighborIndex];
+              RootBlossom<edge_weight> &blossom1 = *vertex1.rootBlossom;
+              if (blossom1.label != LABEL_OUTER || &blossom1 == &blossom0)
+              {
+                continue;
+              }
+
+              vertexIterator0->resistance(scratch.resistance, vertex1);
+
+              assert(!(scratch.resistance & 1u));
+
+              const auto blossom1Index = rootBlossomPool.getIndex(blossom1);
+              auto &&pairResistance = scratch.pairResistances[blossom1Index];
+              Vertex<edge_weight> *&minVertex0 =
+                blossom0.minOuterEdges[blossom1.baseVertex->vertexIndex];
+              Vertex<edge_weight> *&minVertex1 =
+                scratch.pairVertices[blossom1Index];
+              if (
+                scratch.resistance < pairResistance
+                  || (minVertex0
+                        && !(pairResistance < scratch.resistance)
+                        && (outerBlossomRanks[blossom1Index] < task
+                              ? precedes(
+                                  *vertexIterator0,
+                                  vertex1,
+                                  *minVertex0,
+                                  *minVertex1)
+                              : precedes(
+                                  vertex1,
+                                  *vertexIterator0,
+                                  *minVertex1,
+                                  *minVertex0))))
+              {
+                pairResistance = scratch.resistance;
+                minVertex0 = vertexIterator0;
+                minVertex1 = &vertex1;
+
+                if (scratch.resistance < minResistance)
+                {
+                  minResistance = scratch.resistance;
+                }
+              }
+            }
+          }
+          blossom0.minOuterEdgeResistance = minResistance;
+        });
+    }
+
     template <typename edge_weight>
     void Graph<edge_weight>::initializeOuterOuterEdges(
       RootBlossom<edge_weight> &blossom0
-    ) const &
+    ) &
     {
+      if (!filterOuterOuterScans && getVertexRangeCount() > 1u)
+      {
+        initializeOuterOuterEdgesInParallel(blossom0, getOuterRootBlossoms());
+        return;
+      }
       edge_weight resistance0 = aboveMaxEdgeWeight;
+      if (filterOuterOuterScans)
+      {
+        initializeFilteredOuterOuterEdges(
+          blossom0,
+          getOuterVertexPositions(*this),
+          resistance0);
+        return;
+      }
       edge_weight resistance1 = aboveMaxEdgeWeight;
       initializeOuterOuterEdges(blossom0, resistance0, resistance1);
     }
@@ -318,10 +835,26 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
      * their values.
      */
     template <typename edge_weight>
-    void Graph<edge_weight>::initializeOuterOuterEdges() const &
+    void Graph<edge_weight>::initializeOuterOuterEdges() &
     {
+      if (getVertexRangeCount() > 1u)
+      {
+        if (filterOuterOuterScans)
+        {
+          initializeFilteredOuterOuterEdgesInParallel(getOuterRootBlossoms());
+        }
+        else
+        {
+          initializeOuterOuterEdgesInParallel(getOuterRootBlossoms());
+        }
+        return;
+      }
       edge_weight resistance0 = aboveMaxEdgeWeight;
       edge_weight resistance1 = aboveMaxEdgeWeight;
+      const std::vector<vertex_index> outerVertexPositions =
+        filterOuterOuterScans
+          ? getOuterVertexPositions(*this)
+          : std::vector<vertex_index>();
       for (
         auto iterator0 = rootBlossomPool.begin();
         iterator0 != rootBlossomPool.end();
@@ -329,62 +862,51 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
       {
         if (iterator0->label == LABEL_OUTER)
         {
-          initializeOuterOuterEdges(*iterator0, resistance0, resistance1);
+          if (filterOuterOuterScans)
+          {
+            initializeFilteredOuterOuterEdges(
+              *iterator0,
+              outerVertexPositions,
+              resistance0);
+          }
+          else
+          {
+            initializeOuterOuterEdges(*iterator0, resistance0, resistance1);
+          }
         }
       }
     }
 
     /**
-     * Compute the minimum resistance between outer vertices in different
-     * RootBlossoms.
+     * Add an OUTER or INNER RootBlossom to the heap matching its label. INNER
+     * RootBlossoms that are Vertexes have no dual variable to track, so they
+     * are skipped.
      */
     template <typename edge_weight>
-    void Graph<edge_weight>::initializeMinOuterOuterEdgeResistance(
-      RootBlossom<edge_weight> *&minOuterOuterEdgeResistanceRootBlossom,
-      edge_weight &minOuterOuterEdgeResistance
-    ) const
+    void Graph<edge_weight>::pushRootBlossom(
+      RootBlossom<edge_weight> &rootBlossom
+    ) &
     {
-      minOuterOuterEdgeResistance = aboveMaxEdgeWeight;
-      minOuterOuterEdgeResistanceRootBlossom = nullptr;
-      for (
-        auto rootBlossomIterator = rootBlossomPool.begin();
-        rootBlossomIterator != rootBlossomPool.end();
-        ++rootBlossomIterator)
+      if (rootBlossom.label == LABEL_OUTER)
       {
-        if (rootBlossomIterator->label == LABEL_OUTER)
-        {
-          updateMinOuterOuterEdgeResistance(
-            *rootBlossomIterator,
-            minOuterOuterEdgeResistanceRootBlossom,
-            minOuterOuterEdgeResistance);
-        }
+        outerRootBlossomHeap.push(rootBlossom);
+      }
+      else if (
+        rootBlossom.label == LABEL_INNER && !rootBlossom.rootChild.isVertex)
+      {
+        innerRootBlossomHeap.push(rootBlossom);
       }
     }
 
     /**
-     * Compute the minimum blossom dual variable among inner blossoms.
+     * Empty the heaps at the end of the augmentation step, while all their
+     * RootBlossoms still exist.
      */
     template <typename edge_weight>
-    void Graph<edge_weight>::initializeMinInnerDualVariable(
-      ParentBlossom<edge_weight> *&minInnerDualVariableBlossom,
-      edge_weight &minInnerDualVariable
-    ) const
+    void Graph<edge_weight>::clearRootBlossomHeaps() &
     {
-      minInnerDualVariable = aboveMaxEdgeWeight;
-      minInnerDualVariableBlossom = nullptr;
-      for (
-        auto rootBlossomIterator = rootBlossomPool.begin();
-        rootBlossomIterator != rootBlossomPool.end();
-        ++rootBlossomIterator)
-      {
-        if (rootBlossomIterator->label == LABEL_INNER)
-        {
-          updateMinInnerDualVariable(
-            *rootBlossomIterator,
-            minInnerDualVariableBlossom,
-            minInnerDualVariable);
-        }
-      }
+      outerRootBlossomHeap.clear();
+      innerRootBlossomHeap.clear();
     }
 
     /**
@@ -415,35 +937,107 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
         return false;
       }
 
-      initializeInnerOuterEdges();
-      initializeOuterOuterEdges();
+      {
+        MATCHING_STATS_TIME(stats, edgeInitializationNanoseconds);
+        initializeInnerOuterEdges();
+        initializeOuterOuterEdges();
+        for (
+          auto rootBlossomIterator = rootBlossomPool.begin();
+          rootBlossomIterator != rootBlossomPool.end();
+          ++rootBlossomIterator)
+        {
+          pushRootBlossom(*rootBlossomIterator);
+        }
+      }
 
-      // Set up variables needed to choose the dual variable adjustment, which
-      // will be update incrementally.
       edge_weight minOuterOuterEdgeResistance = aboveMaxEdgeWeight;
-      RootBlossom<edge_weight> *minOuterOuterEdgeResistanceRootBlossom;
-      initializeMinOuterOuterEdgeResistance(
-        minOuterOuterEdgeResistanceRootBlossom,
-        minOuterOuterEdgeResistance);
-
       edge_weight minInnerDualVariable = aboveMaxEdgeWeight;
-      ParentBlossom<edge_weight> *minInnerDualVariableBlossom{ };
 
       // The loop for manipulating blossoms and adjusting the dual variables.
       while (true)
       {
         // Compute variables needed to choose the dual variable adjustment.
+        RootBlossom<edge_weight> *minOuterOuterEdgeResistanceRootBlossom{ };
+        minOuterOuterEdgeResistance = aboveMaxEdgeWeight;
+        if (
+          !outerRootBlossomHeap.empty()
+            && outerRootBlossomHeap.top().minOuterEdgeResistance
+                < aboveMaxEdgeWeight)
+        {
+          minOuterOuterEdgeResistanceRootBlossom = &outerRootBlossomHeap.top();
+          minOuterOuterEdgeResistance =
+            minOuterOuterEdgeResistanceRootBlossom->minOuterEdgeResistance;
+        }
+        assert(
+          !minOuterOuterEdgeResistanceRootBlossom
+            || !(minOuterOuterEdgeResistance & 1u));
+
+        ParentBlossom<edge_weight> *minInnerDualVariableBlossom{ };
+        minInnerDualVariable = aboveMaxEdgeWeight;
+        if (!innerRootBlossomHeap.empty())
+        {
+          minInnerDualVariableBlossom =
+            &static_cast<ParentBlossom<edge_weight> &>(
+              innerRootBlossomHeap.top().rootChild);
+          minInnerDualVariable = minInnerDualVariableBlossom->dualVariable;
+        }
+        assert(!minInnerDualVariableBlossom || !(minInnerDualVariable & 1u));
+
         edge_weight minInnerOuterEdgeResistance = aboveMaxEdgeWeight;
         Vertex<edge_weight> *minInnerOuterEdgeResistanceVertex{ };
-        for (Vertex<edge_weight> &vertex : *this)
         {
-          if (
-            (vertex.rootBlossom->label == LABEL_FREE
-                || vertex.rootBlossom->label == LABEL_ZERO
-            ) && vertex.minOuterEdgeResistance < minInnerOuterEdgeResistance
-          ) {
-            minInnerOuterEdgeResistance = vertex.minOuterEdgeResistance;
-            minInnerOuterEdgeResistanceVertex = &vertex;
+          // Each range finds its first minimum, and the ranges are combined
+          // in order, so the first minimum overall is chosen.
+          const typename Graph<edge_weight>::size_type rangeCount =
+            getVertexRangeCount();
+          std::vector<edge_weight> rangeMins(
+            rangeCount - 1u,
+            aboveMaxEdgeWeight);
+          std::vector<Vertex<edge_weight> *> rangeMinVertices(
+            rangeCount - 1u);
+          forEachVertexRange(
+            rangeCount,
+            [this,
+              &minInnerOuterEdgeResistance,
+              &minInnerOuterEdgeResistanceVertex,
+              &rangeMins,
+              &rangeMinVertices](
+              const typename Graph<edge_weight>::size_type range,
+              const typename Graph<edge_weight>::size_type begin,
+              const typename Graph<edge_weight>::size_type end)
+            {
+              edge_weight &minResistance =
+                range ? rangeMins[range - 1u] : minInnerOuterEdgeResistance;
+              Vertex<edge_weight> *&minVertex =
+                range
+                  ? rangeMinVertices[range - 1u]
+                  : minInnerOuterEdgeResistanceVertex;
+              for (
+                typename Graph<edge_weight>::size_type index = begin;
+                index < end;
+                ++index)
+              {
+                Vertex<edge_weight> &vertex = (*this)[index];
+                if (
+                  (vertex.rootBlossom->label == LABEL_FREE
+                      || vertex.rootBlossom->label == LABEL_ZERO
+                  ) && vertex.minOuterEdgeResistance < minResistance
+                ) {
+                  minResistance = vertex.minOuterEdgeResistance;
+                  minVertex = &vertex;
+                }
+              }
+            });
+          for (
+            typename Graph<edge_weight>::size_type range = 1u;
+            range < rangeCount;
+            ++range)
+          {
+            if (rangeMins[range - 1u] < minInnerOuterEdgeResistance)
+            {
+              minInnerOuterEdgeResistance = rangeMins[range - 1u];
+              minInnerOuterEdgeResistanceVertex = rangeMinVertices[range - 1u];
+            }
           }
         }
 
@@ -459,64 +1053,79 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
           );
         if (dualAdjustment)
         {
-          edge_weight twiceAdjustment = dualAdjustment << 1;
+          MATCHING_STATS_COUNT(stats, dualAdjustments);
+          MATCHING_STATS_TIME(stats, dualAdjustmentNanoseconds);
+          const edge_weight twiceAdjustment = dualAdjustment << 1;
           minOuterDualVariable -= dualAdjustment;
           minInnerOuterEdgeResistance -= dualAdjustment;
           minOuterOuterEdgeResistance -= twiceAdjustment;
           minInnerDualVariable -= twiceAdjustment;
 
-          for (
-            typename Graph<edge_weight>::iterator vertexIterator =
-              this->begin();
-            vertexIterator != this->end();
-            ++vertexIterator)
-          {
-            RootBlossom<edge_weight> &rootBlossom =
-              *vertexIterator->rootBlossom;
-            Label label = rootBlossom.label;
-            if (label == LABEL_OUTER)
-            {
-              vertexIterator->dualVariable -= dualAdjustment;
-            }
-            else if (label == LABEL_INNER)
-            {
-              vertexIterator->dualVariable += dualAdjustment;
-            }
-            else if (
-              vertexIterator->minOuterEdgeResistance < aboveMaxEdgeWeight)
-            {
-              vertexIterator->minOuterEdgeResistance -= dualAdjustment;
-            }
-            assert(vertexIterator->dualVariable <= aboveMaxEdgeWeight >> 1);
-            if (rootBlossom.baseVertex == &*vertexIterator)
+          forEachVertexRange(
+            getVertexRangeCount(),
+            [this, &dualAdjustment, &twiceAdjustment](
+              const typename Graph<edge_weight>::size_type,
+              const typename Graph<edge_weight>::size_type begin,
+              const typename Graph<edge_weight>::size_type end)
             {
-              if (label == LABEL_OUTER)
+              for (
+                typename Graph<edge_weight>::iterator vertexIterator =
+                  this->begin() + begin;
+                vertexIterator != this->begin() + end;
+                ++vertexIterator)
               {
-                if (rootBlossom.minOuterEdgeResistance < aboveMaxEdgeWeight)
+                RootBlossom<edge_weight> &rootBlossom =
+                  *vertexIterator->rootBlossom;
+                Label label = rootBlossom.label;
+                if (label == LABEL_OUTER)
                 {
-                  rootBlossom.minOuterEdgeResistance -= twiceAdjustment;
+                  vertexIterator->dualVariable -= dualAdjustment;
                 }
-                if (!rootBlossom.rootChild.isVertex)
+                else if (label == LABEL_INNER)
                 {
-                  static_cast<ParentBlossom<edge_weight> &>(
-                    rootBlossom.rootChild
-                  ).dualVariable += twiceAdjustment;
+                  vertexIterator->dualVariable += dualAdjustment;
+                }
+                else if (
+                  vertexIterator->minOuterEdgeResistance < aboveMaxEdgeWeight)
+                {
+                  vertexIterator->minOuterEdgeResistance -= dualAdjustment;
+                }
+                assert(
+                  vertexIterator->dualVariable <= aboveMaxEdgeWeight >> 1);
+                if (rootBlossom.baseVertex == &*vertexIterator)
+                {
+                  if (label == LABEL_OUTER)
+                  {
+                    if (
+                      rootBlossom.minOuterEdgeResistance < aboveMaxEdgeWeight)
+                    {
+                      rootBlossom.minOuterEdgeResistance -= twiceAdjustment;
+                    }
+                    if (!rootBlossom.rootChild.isVertex)
+                    {
+                      static_cast<ParentBlossom<edge_weight> &>(
+                        rootBlossom.rootChild
+                      ).dualVariable += twiceAdjustment;
+                    }
+                  }
+                  else if (
+                    label == LABEL_INNER && !rootBlossom.rootChild.isVertex)
+                  {
+                    static_cast<ParentBlossom<edge_weight> &>(
+                        rootBlossom.rootChild
+                      ).dualVariable -= twiceAdjustment;
+                  }
                 }
               }
-              else if (label == LABEL_INNER && !rootBlossom.rootChild.isVertex)
-              {
-                static_cast<ParentBlossom<edge_weight> &>(
-                    rootBlossom.rootChild
-                  ).dualVariable -= twiceAdjustment;
-              }
-            }
-          }
+            });
         }
 
         // Find the condition that halted the dual variable adjustment, and
         // apply the relevant change.
         if (!minOuterDualVariable) {
           // An OUTER blossom has a Vertex with dualVariable 0.
+          MATCHING_STATS_COUNT(stats, augmentations);
+          clearRootBlossomHeaps();
           augmentToSource<edge_weight>(minOuterDualVariableVertex, nullptr);
           return true;
         }
@@ -528,6 +1137,8 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
           // The resistance between a ZERO Vertex and an OUTER Vertex is 0.
           // Augment from the ZERO Vertex to the OUTER Vertex.
 
+          MATCHING_STATS_COUNT(stats, augmentations);
+          clearRootBlossomHeaps();
           augmentToSource(
             minInnerOuterEdgeResistanceVertex->minOuterEdge,
             minInnerOuterEdgeResistanceVertex);
@@ -591,6 +1202,8 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
           if (path.front()->rootBlossom == path.back()->rootBlossom)
           {
             // Form a new OUTER blossom.
+            MATCHING_STATS_COUNT(stats, blossomShrinks);
+            MATCHING_STATS_TIME(stats, blossomShrinkNanoseconds);
             while (
               (*std::next(path.begin(), 1))->rootBlossom
                 == (*std::next(path.rbegin(), 1))->rootBlossom)
@@ -609,6 +1222,7 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
               rootBlossomPool.construct(path.cbegin(), path.cend(), *this);
 
             assert(newBlossom.label == LABEL_OUTER);
+            pushRootBlossom(newBlossom);
             for (
               auto iterator = newBlossom.rootChild.vertexListHead;
               iterator;
@@ -619,16 +1233,12 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
                 minOuterDualVariableVertex,
                 minOuterDualVariable);
             }
-            initializeMinOuterOuterEdgeResistance(
-              minOuterOuterEdgeResistanceRootBlossom,
-              minOuterOuterEdgeResistance);
-            initializeMinInnerDualVariable(
-              minInnerDualVariableBlossom,
-              minInnerDualVariable);
           }
           else
           {
             // Augment from vertex0 to vertex1.
+            MATCHING_STATS_COUNT(stats, augmentations);
+            clearRootBlossomHeaps();
             augmentToSource(vertex0, vertex1);
             augmentToSource(vertex1, vertex0);
 
@@ -639,6 +1249,7 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
         {
           // The resistance between a FREE Vertex and an OUTER Vertex is 0.
           // Label the FREE Vertex and its match.
+          MATCHING_STATS_COUNT(stats, labelings);
           assert(
             minInnerOuterEdgeResistanceVertex->rootBlossom->label
               == LABEL_FREE);
@@ -656,6 +1267,8 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
             minInnerOuterEdgeResistanceVertex;
           updateInnerOuterEdges(matchedRootBlossom);
           initializeOuterOuterEdges(matchedRootBlossom);
+          pushRootBlossom(matchedRootBlossom);
+          pushRootBlossom(*minInnerOuterEdgeResistanceVertex->rootBlossom);
           for (
             auto iterator = matchedRootBlossom.rootChild.vertexListHead;
             iterator;
@@ -666,19 +1279,14 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
               minOuterDualVariableVertex,
               minOuterDualVariable);
           }
-          updateMinOuterOuterEdgeResistance(
-            matchedRootBlossom,
-            minOuterOuterEdgeResistanceRootBlossom,
-            minOuterOuterEdgeResistance);
-          updateMinInnerDualVariable(
-            *minInnerOuterEdgeResistanceVertex->rootBlossom,
-            minInnerDualVariableBlossom,
-            minInnerDualVariable);
 
           continue;
         }
         else if (!minInnerDualVariable)
         {
+          MATCHING_STATS_COUNT(stats, blossomExpansions);
+          MATCHING_STATS_TIME(stats, blossomExpansionNanoseconds);
+          innerRootBlossomHeap.erase(*minInnerDualVariableBlossom->rootBlossom);
           rootBlossomPool.hide(*minInnerDualVariableBlossom->rootBlossom);
 
           // An INNER RootBlossom has dualVariable zero. Dissolve it.
@@ -760,11 +1368,8 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
                   minOuterDualVariableVertex,
                   minOuterDualVariable);
               }
-              updateMinOuterOuterEdgeResistance(
-                *currentChild->rootBlossom,
-                minOuterOuterEdgeResistanceRootBlossom,
-                minOuterOuterEdgeResistance);
             }
+            pushRootBlossom(*currentChild->rootBlossom);
 
             if (currentChild == &(connectForward ? connectChild : rootChild))
             {
@@ -776,20 +1381,57 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
 
           rootBlossomPool.destroy(*minInnerDualVariableBlossom->rootBlossom);
           parentBlossomPool.destroy(*minInnerDualVariableBlossom);
+        }
+      }
+    }
 
-          initializeMinInnerDualVariable(
-            minInnerDualVariableBlossom,
-            minInnerDualVariable);
+    /**
+     * Rebuild the neighbors lists of the Vertexes whose edge weights changed.
+     */
+    template <typename edge_weight>
+    void Graph<edge_weight>::initializeNeighbors() &
+    {
+      for (Vertex<edge_weight> &vertex : *this)
+      {
+        if (vertex.neighborsStale)
+        {
+          vertex.neighbors.clear();
+          for (
+            vertex_index neighborIndex{ };
+            neighborIndex < this->size();
+            ++neighborIndex)
+          {
+            if (
+              neighborIndex != vertex.vertexIndex
+                && vertex.edgeWeights[neighborIndex])
+            {
+              vertex.neighbors.push_back(neighborIndex);
+            }
+          }
+          vertex.neighborsStale = false;
         }
       }
     }
 
     /**
-     * Find the maximum matching for the graph.
+     * Find the maximum matching for the graph. If filterOuterOuterScans_ is
+     * set, the edges of weight zero are skipped when scanning for the minimum
+     * outer-outer edges, which is faster when most edges have weight zero, and
+     * produces the same matching.
      */
     template <typename edge_weight>
-    void Graph<edge_weight>::computeMatching() &
+    void Graph<edge_weight>::computeMatching(
+      const bool filterOuterOuterScans_
+    ) &
     {
+      MATCHING_STATS_COUNT(stats, computations);
+      MATCHING_STATS_TIME(stats, computationNanoseconds);
+      filterOuterOuterScans = filterOuterOuterScans_;
+      if (filterOuterOuterScans)
+      {
+        initializeNeighbors();
+      }
+
       // Make sure all exposed Vertex dualVariables have the same parity.
       for (
         auto rootBlossomIterator = rootBlossomPool.begin();
@@ -846,6 +1488,71 @@ typename std::conditional<std::is_trivially_copyable<a>::value, a, a &>::type);
 
       // Continue augmenting the matching until it is maximum.
       while (augmentMatching()) { }
+
+      MATCHING_STATS_MAX(stats, peakAllocatedBytes, getAllocatedBytes());
+    }
+
+    /**
+     * Split the edge scans and dual variable adjustments of later
+     * computations across threadCount threads. The results do not depend on
+     * the number of threads.
+     */
+    template <typename edge_weight>
+    void Graph<edge_weight>::setThreadCount(const std::size_t threadCount) &
+    {
+      threadPool.reset();
+      filteredScanScratch.clear();
+      if (threadCount > 1u)
+      {
+        threadPool =
+          std::make_unique<utility::threadpool::ThreadPool>(threadCount);
+        for (std::size_t thread{ }; thread < threadCount; ++thread)
+        {
+          filteredScanScratch.push_back(
+            FilteredScanScratch{
+              typename edge_weight_traits<edge_weight>::vector(
+                typename
+                    edge_weight_traits<edge_weight>::vector::size_type{
+                      vertexCapacity
+                    }
+                  + 1u,
+                aboveMaxEdgeWeight),
+              std::vector<Vertex<edge_weight> *>(vertexCapacity + 1u),
+              aboveMaxEdgeWeight
+            });
+        }
+      }
+    }
+
+    /**
+     * Return the number of bytes of heap memory held by the Graph between
+     * computations, not counting the scratch space of the computations
+     * themselves.
+     */
+    template <typename edge_weight>
+    std::size_t Graph<edge_weight>::getAllocatedBytes() const &
+    {
+      std::size_t result =
+        this->capacity() * sizeof(Vertex<edge_weight>)
+          + rootBlossomPool.getAllocatedBytes()
+          + parentBlossomPool.getAllocatedBytes()
+          + detail::getAllocatedBytes(vertexEdgeWeights)
+          + detail::getAllocatedBytes(vertexDualVariables)
+          + detail::getAllocatedBytes(vertexMinOuterEdgeResistances)
+          + detail::getAllocatedBytes(rootBlossomMinOuterEdgeResistances)
+          + detail::getAllocatedBytes(rootBlossomMinOuterEdges)
+          + detail::getAllocatedBytes(rootBlossomPairResistances);
+      for (const Vertex<edge_weight> &vertex : *this)
+      {
+        result += detail::getAllocatedBytes(vertex.neighbors);
+      }
+      for (const FilteredScanScratch &scratch : filteredScanScratch)
+      {
+        result +=
+          detail::getAllocatedBytes(scratch.pairResistances)
+            + detail::getAllocatedBytes(scratch.pairVertices);
+      }
+      return result;
     }
 
 #define GRAPH_INSTANTIATION(a) template class Graph<a>;
@@ -3,6 +3,7 @@
 
 #include <cassert>
 #include <stdexcept>
+#include <vector>
 
 #include "graphsig.h"
 #include "parentblossomsig.h"
@@ -20,14 +21,26 @@ namespace matching
       : rootBlossomPool(
           typename decltype(rootBlossomPool)::size_type{ capacity } + 1u),
         parentBlossomPool(capacity / 2u),
+        vertexEdgeWeights(capacity, maxEdgeWeight & 0u),
         vertexDualVariables(capacity, maxEdgeWeight & 0u),
+        vertexMinOuterEdgeResistances(capacity, maxEdgeWeight),
         rootBlossomMinOuterEdgeResistances(
           typename
               decltype(rootBlossomMinOuterEdgeResistances)
                 ::size_type{ capacity }
             + 1u,
           maxEdgeWeight),
-        aboveMaxEdgeWeight((maxEdgeWeight << 2) + 1u)
+        rootBlossomMinOuterEdges(
+          typename decltype(rootBlossomMinOuterEdges)::size_type{ capacity }
+            * capacity
+            + capacity),
+        vertexCapacity(capacity),
+        aboveMaxEdgeWeight((maxEdgeWeight << 2) + 1u),
+        rootBlossomPairResistances(
+          typename
+              decltype(rootBlossomPairResistances)::size_type{ capacity }
+            + 1u,
+          maxEdgeWeight)
     {
       assert(aboveMaxEdgeWeight >> 2 == maxEdgeWeight);
       if (!(typename decltype(rootBlossomPool)::size_type{ capacity } + 1u))
@@ -40,10 +53,21 @@ namespace matching
       {
         throw std::length_error("");
       }
+      if (capacity > ~typename decltype(vertexEdgeWeights)::size_type{ })
+      {
+        throw std::length_error("");
+      }
       if (capacity > ~typename decltype(vertexDualVariables)::size_type{ })
       {
         throw std::length_error("");
       }
+      if (
+        capacity
+          > ~typename decltype(vertexMinOuterEdgeResistances)::size_type{ }
+      )
+      {
+        throw std::length_error("");
+      }
       if (
         !(typename
               decltype(rootBlossomMinOuterEdgeResistances)
@@ -53,6 +77,20 @@ namespace matching
       {
         throw std::length_error("");
       }
+      if (
+        !(typename decltype(rootBlossomPairResistances)::size_type{ capacity }
+            + 1u)
+      )
+      {
+        throw std::length_error("");
+      }
+      if (
+        capacity
+          && (rootBlossomMinOuterEdges.size() / capacity != capacity + 1u
+                || rootBlossomMinOuterEdges.size() % capacity))
+      {
+        throw std::length_error("");
+      }
       this->reserve(capacity);
     }
 
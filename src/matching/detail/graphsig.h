@@ -1,10 +1,16 @@
 #ifndef GRAPHSIG_H
 #define GRAPHSIG_H
 
+#include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <vector>
 
+#include <utility/heap.h>
 #include <utility/memory.h>
+#include <utility/threadpool.h>
+
+#include "../stats.h"
 
 #include "types.h"
 
@@ -19,6 +25,30 @@ namespace matching
     template <typename>
     struct Vertex;
 
+    /**
+     * Heap traits ordering OUTER RootBlossoms by minOuterEdgeResistance.
+     */
+    template <typename edge_weight>
+    struct OuterRootBlossomOrder
+    {
+      static bool less(
+        const RootBlossom<edge_weight> &,
+        const RootBlossom<edge_weight> &);
+      static std::size_t &position(RootBlossom<edge_weight> &);
+    };
+    /**
+     * Heap traits ordering INNER RootBlossoms by the dualVariable of their
+     * rootChild, which must be a ParentBlossom.
+     */
+    template <typename edge_weight>
+    struct InnerRootBlossomOrder
+    {
+      static bool less(
+        const RootBlossom<edge_weight> &,
+        const RootBlossom<edge_weight> &);
+      static std::size_t &position(RootBlossom<edge_weight> &);
+    };
+
     /**
      * The container for the vertices of the graph.
      */
@@ -27,13 +57,35 @@ namespace matching
     {
     public:
       utility::memory::IterablePool<RootBlossom<edge_weight>> rootBlossomPool;
+      /**
+       * The number of RootBlossoms constructed so far, used to number them in
+       * the order of iteration over rootBlossomPool.
+       */
+      std::size_t rootBlossomConstructionCount{ };
       utility::memory::IterablePool<ParentBlossom<edge_weight>>
         parentBlossomPool;
 
+      /**
+       * The weights of the edges between Vertexes. Row vertexIndex holds the
+       * edgeWeights of the Vertex with that vertexIndex. The matrix has room
+       * for every Vertex up to the capacity, so adding a Vertex does not move
+       * any weights.
+       */
+      typename edge_weight_traits<edge_weight>::matrix vertexEdgeWeights;
+      /**
+       * The number of edges of nonzero weight in vertexEdgeWeights, counting
+       * each edge once.
+       */
+      std::size_t nonzeroEdgeCount{ };
       /**
        * Dual variables of the Vertexes, indexed by vertexIndex.
        */
       typename edge_weight_traits<edge_weight>::vector vertexDualVariables;
+      /**
+       * Vertex minOuterEdgeResistances, indexed by vertexIndex.
+       */
+      typename edge_weight_traits<edge_weight>::vector
+        vertexMinOuterEdgeResistances;
       /**
        * RootBlossom minOuterEdgeResistances, indexed by
        * utility::memory::IterablePool<RootBlossom<edge_weight>>::getIndex().
@@ -41,6 +93,19 @@ namespace matching
       typename edge_weight_traits<edge_weight>::vector
         rootBlossomMinOuterEdgeResistances;
 
+      /**
+       * The minOuterEdges of the RootBlossoms, stored as one matrix with a row
+       * for each slot of rootBlossomPool, so that forming and dissolving
+       * blossoms does not allocate. Each row has room for every Vertex up to
+       * the capacity.
+       */
+      std::vector<Vertex<edge_weight> *> rootBlossomMinOuterEdges;
+      /**
+       * The number of Vertexes the Graph has room for, which is the row size
+       * of rootBlossomMinOuterEdges.
+       */
+      typename Graph<edge_weight>::size_type vertexCapacity;
+
       /**
        * A number that is strictly greater than twice the maximum edge weight
        * stored internally, that is, strictly greater than four times the
@@ -48,32 +113,125 @@ namespace matching
        */
       edge_weight aboveMaxEdgeWeight;
 
+      /**
+       * Whether the current computation only visits the edges of nonzero
+       * weight, using the Vertex neighbors lists, when it scans for the minimum
+       * outer-outer edges.
+       */
+      bool filterOuterOuterScans{ };
+      /**
+       * Scratch space for filtered outer-outer scans: the minimum resistance
+       * found so far between the RootBlossom being initialized and each other
+       * RootBlossom, indexed by
+       * utility::memory::IterablePool<RootBlossom<edge_weight>>::getIndex().
+       */
+      typename edge_weight_traits<edge_weight>::vector
+        rootBlossomPairResistances;
+
+      /**
+       * The OUTER RootBlossoms, ordered by minOuterEdgeResistance. Dual
+       * variable adjustments lower all the keys by the same amount, so the heap
+       * only changes when a RootBlossom is labeled, formed or dissolved, or
+       * when an outer edge of lower resistance is found.
+       *
+       * Only valid during the augmentation step.
+       */
+      utility::heap::AddressableHeap<
+          RootBlossom<edge_weight>,
+          OuterRootBlossomOrder<edge_weight>>
+        outerRootBlossomHeap;
+      /**
+       * The INNER RootBlossoms that are not Vertexes, ordered by dual variable.
+       *
+       * Only valid during the augmentation step.
+       */
+      utility::heap::AddressableHeap<
+          RootBlossom<edge_weight>,
+          InnerRootBlossomOrder<edge_weight>>
+        innerRootBlossomHeap;
+
+      /**
+       * The work done so far, if the build gathers statistics.
+       */
+      Stats stats;
+
+      /**
+       * The threads sharing the edge scans and dual variable adjustments, or
+       * null if the Graph only uses the calling thread.
+       */
+      std::unique_ptr<utility::threadpool::ThreadPool> threadPool;
+
       Graph(typename Graph<edge_weight>::size_type, const edge_weight &);
       Graph(Graph &) = delete;
 
       ~Graph();
 
-      void computeMatching() &;
+      void computeMatching(bool) &;
+      void setThreadCount(std::size_t) &;
 
       void updateInnerOuterEdges(const RootBlossom<edge_weight> &) &;
 
+      /**
+       * Return the row of rootBlossomMinOuterEdges belonging to the
+       * RootBlossom.
+       */
+      Vertex<edge_weight> **getMinOuterEdges(
+        const RootBlossom<edge_weight> &rootBlossom
+      ) &
+      {
+        return
+          rootBlossomMinOuterEdges.data()
+            + rootBlossomPool.getIndex(rootBlossom) * vertexCapacity;
+      }
+
+      std::size_t getAllocatedBytes() const &;
+
     private:
+      /**
+       * Per-thread scratch space for filtered outer-outer scans run in
+       * parallel, playing the role of rootBlossomPairResistances.
+       */
+      struct FilteredScanScratch
+      {
+        typename edge_weight_traits<edge_weight>::vector pairResistances;
+        /**
+         * The Vertexes of the other RootBlossoms on the minimum edges found
+         * so far, indexed like pairResistances.
+         */
+        std::vector<Vertex<edge_weight> *> pairVertices;
+        edge_weight resistance;
+      };
+      std::vector<FilteredScanScratch> filteredScanScratch;
+
+      typename Graph<edge_weight>::size_type getVertexRangeCount() const &;
+      template <class Function>
+      void forEachVertexRange(
+        typename Graph<edge_weight>::size_type,
+        const Function &) &;
+      std::vector<RootBlossom<edge_weight> *> getOuterRootBlossoms() const &;
+
       void initializeLabeling() const &;
       void initializeInnerOuterEdges() &;
-      void initializeOuterOuterEdges(RootBlossom<edge_weight> &) const &;
+      void initializeNeighbors() &;
+      void initializeOuterOuterEdges(RootBlossom<edge_weight> &) &;
       void initializeOuterOuterEdges(
         RootBlossom<edge_weight> &,
         edge_weight &,
-        edge_weight &) const &;
-      void initializeOuterOuterEdges() const &;
-      void initializeMinOuterOuterEdgeResistance(
-        RootBlossom<edge_weight> *&,
-        edge_weight &
-      ) const;
-      void initializeMinInnerDualVariable(
-        ParentBlossom<edge_weight> *&,
-        edge_weight &
-      ) const;
+        edge_weight &) &;
+      void initializeFilteredOuterOuterEdges(
+        RootBlossom<edge_weight> &,
+        const std::vector<vertex_index> &,
+        edge_weight &) &;
+      void initializeOuterOuterEdges() &;
+      void initializeOuterOuterEdgesInParallel(
+        const std::vector<RootBlossom<edge_weight> *> &) &;
+      void initializeFilteredOuterOuterEdgesInParallel(
+        const std::vector<RootBlossom<edge_weight> *> &) &;
+      void initializeOuterOuterEdgesInParallel(
+        RootBlossom<edge_weight> &,
+        const std::vector<RootBlossom<edge_weight> *> &) &;
+      void pushRootBlossom(RootBlossom<edge_weight> &) &;
+      void clearRootBlossomHeaps() &;
 
       bool augmentMatching() &;
     };
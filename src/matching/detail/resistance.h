@@ -0,0 +1,262 @@
+#ifndef MATCHINGDETAILRESISTANCE_H
+#define MATCHINGDETAILRESISTANCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace matching
+{
+  namespace detail
+  {
+    namespace resistance
+    {
+      /**
+       * The number of elements of a DynamicUintVector whose pieces are
+       * interleaved, matching the number of 64-bit lanes in an AVX2 register.
+       */
+      constexpr std::size_t blockSize = 4u;
+
+      /**
+       * The position of piece zero of element index in a DynamicUintVector
+       * whose elements have the given number of pieces.
+       */
+      constexpr std::size_t offset(
+        const std::size_t index,
+        const std::size_t pieces)
+      {
+        return index / blockSize * blockSize * pieces + index % blockSize;
+      }
+
+      /**
+       * Compute one piece of addend0 + addend1 - subtrahend, given the pieces
+       * of the operands and the carry and borrow left by the lower pieces.
+       */
+      inline std::uintmax_t piece(
+        const std::uintmax_t addend0,
+        const std::uintmax_t addend1,
+        const std::uintmax_t subtrahend,
+        std::uintmax_t &carry,
+        std::uintmax_t &borrow)
+      {
+        const std::uintmax_t sum = addend0 + addend1;
+        const std::uintmax_t carriedSum = sum + carry;
+        carry = (sum < addend0) | (carriedSum < sum);
+        const std::uintmax_t difference = carriedSum - subtrahend;
+        const std::uintmax_t borrowedDifference = difference - borrow;
+        borrow = (carriedSum < subtrahend) | (difference < borrow);
+        return borrowedDifference;
+      }
+
+      /**
+       * Determine whether dualVariable + dualVariable1 - edgeWeight is strictly
+       * less than minResistance, and if so, store it there.
+       *
+       * dualVariable has its pieces stored contiguously. The other arguments
+       * point at piece zero of an element of a DynamicUintVector.
+       */
+      inline bool updateMin(
+        const std::uintmax_t *const dualVariable,
+        const std::uintmax_t *const dualVariable1,
+        const std::uintmax_t *const edgeWeight,
+        std::uintmax_t *const minResistance,
+        const std::size_t pieces)
+      {
+        bool less{ };
+        std::uintmax_t carry{ };
+        std::uintmax_t borrow{ };
+        for (std::size_t k{ }; k < pieces; ++k)
+        {
+          const std::uintmax_t result =
+            piece(
+              dualVariable[k],
+              dualVariable1[k * blockSize],
+              edgeWeight[k * blockSize],
+              carry,
+              borrow);
+          const std::uintmax_t min = minResistance[k * blockSize];
+          less = result < min || (result == min && less);
+        }
+        if (less)
+        {
+          carry = 0u;
+          borrow = 0u;
+          for (std::size_t k{ }; k < pieces; ++k)
+          {
+            minResistance[k * blockSize] =
+              piece(
+                dualVariable[k],
+                dualVariable1[k * blockSize],
+                edgeWeight[k * blockSize],
+                carry,
+                borrow);
+          }
+        }
+        return less;
+      }
+
+#ifdef __AVX2__
+      /**
+       * Lane-wise unsigned 64-bit comparison.
+       */
+      inline __m256i lessThan(const __m256i value0, const __m256i value1)
+      {
+        const __m256i sign =
+          _mm256_set1_epi64x(std::numeric_limits<long long>::min());
+        return
+          _mm256_cmpgt_epi64(
+            _mm256_xor_si256(value1, sign),
+            _mm256_xor_si256(value0, sign));
+      }
+
+      /**
+       * The vector form of piece(), where carry and borrow are lane masks.
+       */
+      inline __m256i piece(
+        const __m256i addend0,
+        const __m256i addend1,
+        const __m256i subtrahend,
+        __m256i &carry,
+        __m256i &borrow)
+      {
+        const __m256i sum = _mm256_add_epi64(addend0, addend1);
+        const __m256i carriedSum = _mm256_sub_epi64(sum, carry);
+        carry =
+          _mm256_or_si256(
+            lessThan(sum, addend0),
+            lessThan(carriedSum, sum));
+        const __m256i difference = _mm256_sub_epi64(carriedSum, subtrahend);
+        const __m256i borrowedDifference = _mm256_add_epi64(difference, borrow);
+        borrow =
+          _mm256_or_si256(
+            lessThan(carriedSum, subtrahend),
+            lessThan(difference, borrowedDifference));
+        return borrowedDifference;
+      }
+
+      inline __m256i load(const std::uintmax_t *const source)
+      {
+        return
+          _mm256_loadu_si256(reinterpret_cast<const __m256i_u *>(source));
+      }
+#endif
+
+      /**
+       * For each index i less than count with candidates[i] nonzero, compute
+       * the resistance dualVariable + dualVariables[i] - edgeWeights[i], and if
+       * it is strictly less than minResistances[i], store it there. Set
+       * improved[i] to indicate whether minResistances[i] was changed.
+       *
+       * dualVariable has its pieces stored contiguously. The other arrays are
+       * the data of DynamicUintVectors whose elements have the given number of
+       * pieces.
+       */
+      inline void updateMins(
+        const std::uintmax_t *const dualVariable,
+        const std::uintmax_t *const dualVariables,
+        const std::uintmax_t *const edgeWeights,
+        std::uintmax_t *const minResistances,
+        const std::size_t pieces,
+        const std::size_t count,
+        const unsigned char *const candidates,
+        unsigned char *const improved)
+      {
+        std::size_t index{ };
+#ifdef __AVX2__
+        if constexpr (
+          std::numeric_limits<std::uintmax_t>::digits == 64 && blockSize == 4u)
+        {
+          for (; index + blockSize <= count; index += blockSize)
+          {
+            std::uint32_t candidateBytes;
+            std::memcpy(
+              &candidateBytes,
+              candidates + index,
+              sizeof(candidateBytes));
+            if (!candidateBytes)
+            {
+              std::memset(improved + index, 0, blockSize);
+              continue;
+            }
+            const __m256i candidateMask =
+              _mm256_cmpgt_epi64(
+                _mm256_cvtepu8_epi64(
+                  _mm_cvtsi32_si128(static_cast<int>(candidateBytes))),
+                _mm256_setzero_si256());
+
+            const std::size_t block = index * pieces;
+            __m256i less = _mm256_setzero_si256();
+            __m256i carry = _mm256_setzero_si256();
+            __m256i borrow = _mm256_setzero_si256();
+            for (std::size_t k{ }; k < pieces; ++k)
+            {
+              const std::size_t position = block + k * blockSize;
+              const __m256i result =
+                piece(
+                  _mm256_set1_epi64x(static_cast<long long>(dualVariable[k])),
+                  load(dualVariables + position),
+                  load(edgeWeights + position),
+                  carry,
+                  borrow);
+              const __m256i min = load(minResistances + position);
+              less =
+                _mm256_or_si256(
+                  lessThan(result, min),
+                  _mm256_and_si256(_mm256_cmpeq_epi64(result, min), less));
+            }
+            less = _mm256_and_si256(less, candidateMask);
+
+            const int lessBits =
+              _mm256_movemask_pd(_mm256_castsi256_pd(less));
+            for (std::size_t lane{ }; lane < blockSize; ++lane)
+            {
+              improved[index + lane] = (lessBits >> lane) & 1;
+            }
+            if (lessBits)
+            {
+              carry = _mm256_setzero_si256();
+              borrow = _mm256_setzero_si256();
+              for (std::size_t k{ }; k < pieces; ++k)
+              {
+                const std::size_t position = block + k * blockSize;
+                const __m256i result =
+                  piece(
+                    _mm256_set1_epi64x(static_cast<long long>(dualVariable[k])),
+                    load(dualVariables + position),
+                    load(edgeWeights + position),
+                    carry,
+                    borrow);
+                _mm256_storeu_si256(
+                  reinterpret_cast<__m256i_u *>(minResistances + position),
+                  _mm256_blendv_epi8(
+                    load(minResistances + position),
+                    result,
+                    less));
+              }
+            }
+          }
+        }
+#endif
+        for (; index < count; ++index)
+        {
+          const std::size_t position = offset(index, pieces);
+          improved[index] =
+            candidates[index]
+              && updateMin(
+                  dualVariable,
+                  dualVariables + position,
+                  edgeWeights + position,
+                  minResistances + position,
+                  pieces);
+        }
+      }
+    }
+  }
+}
+
+#endif
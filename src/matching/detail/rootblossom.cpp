@@ -92,6 +92,14 @@ namespace matching
       minOuterEdgeResistance = graph.aboveMaxEdgeWeight;
       for (RootBlossom<edge_weight> *const rootBlossom : originalBlossoms)
       {
+        if (rootBlossom->label == LABEL_OUTER)
+        {
+          graph.outerRootBlossomHeap.erase(*rootBlossom);
+        }
+        else if (graph.innerRootBlossomHeap.contains(*rootBlossom))
+        {
+          graph.innerRootBlossomHeap.erase(*rootBlossom);
+        }
         graph.rootBlossomPool.hide(*rootBlossom);
         rootBlossom->updateRootBlossomInDescendants(*this);
       }
@@ -160,6 +168,7 @@ namespace matching
               }
             }
           }
+          graph.outerRootBlossomHeap.update(*iterator);
         }
       }
 
@@ -1,9 +1,10 @@
 #ifndef ROOTBLOSSOMIMPL_H
 #define ROOTBLOSSOMIMPL_H
 
+#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <iterator>
-#include <stdexcept>
 #include <vector>
 
 #include "blossomsig.h"
@@ -46,20 +47,19 @@ namespace matching
     template <typename edge_weight>
     inline RootBlossom<edge_weight>::RootBlossom(
         Vertex<edge_weight> &child,
-        const vertex_index vertexIndex,
         Graph<edge_weight> &graph)
-      : minOuterEdges(
-          typename decltype(minOuterEdges)::size_type{ vertexIndex } + 1u),
+      : minOuterEdges(graph.getMinOuterEdges(*this)),
         minOuterEdgeResistance(
           graph.rootBlossomMinOuterEdgeResistances
             [graph.rootBlossomPool.getIndex(*this)]),
         rootChild(child),
-        baseVertex(&child)
+        baseVertex(&child),
+        constructionIndex(graph.rootBlossomConstructionCount++)
     {
-      if (minOuterEdges.empty())
-      {
-        throw std::length_error("");
-      }
+      std::fill(
+        minOuterEdges,
+        minOuterEdges + graph.vertexCapacity,
+        nullptr);
     }
     /**
      * Construct a new RootBlossom, using the blossoms of the path of Vertexes
@@ -113,7 +113,7 @@ namespace matching
         Vertex<edge_weight> *const labelingVertex_,
         Vertex<edge_weight> *const labeledVertex_,
         Graph<edge_weight> &graph)
-      : minOuterEdges(rootChild_.rootBlossom->minOuterEdges.size()),
+      : minOuterEdges(graph.getMinOuterEdges(*this)),
         minOuterEdgeResistance(
           graph.rootBlossomMinOuterEdgeResistances
             [graph.rootBlossomPool.getIndex(*this)]),
@@ -122,8 +122,13 @@ namespace matching
         baseVertexMatch(baseVertexMatch_),
         label(label_),
         labelingVertex(labelingVertex_),
-        labeledVertex(labeledVertex_)
+        labeledVertex(labeledVertex_),
+        constructionIndex(graph.rootBlossomConstructionCount++)
     {
+      std::fill(
+        minOuterEdges,
+        minOuterEdges + graph.vertexCapacity,
+        nullptr);
       rootChild.parentBlossom = nullptr;
       rootChild.vertexListTail->nextVertex = nullptr;
       updateRootBlossomInDescendants(*this);
@@ -158,7 +163,7 @@ namespace matching
         const std::vector<RootBlossom<edge_weight> *> &rootBlossoms,
         Graph<edge_weight> &graph,
         const RootBlossom<edge_weight> &baseRoot)
-      : minOuterEdges(baseRoot.minOuterEdges),
+      : minOuterEdges(graph.getMinOuterEdges(*this)),
         minOuterEdgeResistance(
           graph.rootBlossomMinOuterEdgeResistances
             [graph.rootBlossomPool.getIndex(*this)]),
@@ -167,8 +172,13 @@ namespace matching
         baseVertexMatch(baseRoot.baseVertexMatch),
         label(baseRoot.label),
         labelingVertex(baseRoot.labelingVertex),
-        labeledVertex(baseRoot.labeledVertex)
+        labeledVertex(baseRoot.labeledVertex),
+        constructionIndex(graph.rootBlossomConstructionCount++)
     {
+      std::copy(
+        baseRoot.minOuterEdges,
+        baseRoot.minOuterEdges + graph.vertexCapacity,
+        minOuterEdges);
       initializeFromChildren(rootBlossoms, graph);
     }
 
@@ -193,6 +203,55 @@ namespace matching
         }
       }
     }
+
+    /**
+     * Order by minOuterEdgeResistance, breaking ties by constructionIndex so
+     * that the minimum is the first one found by iterating over the pool.
+     */
+    template <typename edge_weight>
+    inline bool OuterRootBlossomOrder<edge_weight>::less(
+      const RootBlossom<edge_weight> &blossom0,
+      const RootBlossom<edge_weight> &blossom1)
+    {
+      return
+        blossom0.minOuterEdgeResistance < blossom1.minOuterEdgeResistance
+          || (!(blossom1.minOuterEdgeResistance
+                  < blossom0.minOuterEdgeResistance)
+                && blossom0.constructionIndex < blossom1.constructionIndex);
+    }
+    template <typename edge_weight>
+    inline std::size_t &OuterRootBlossomOrder<edge_weight>::position(
+      RootBlossom<edge_weight> &blossom)
+    {
+      return blossom.heapPosition;
+    }
+
+    /**
+     * Order by the dual variable of the rootChild, with the same tie-breaking
+     * as OuterRootBlossomOrder.
+     */
+    template <typename edge_weight>
+    inline bool InnerRootBlossomOrder<edge_weight>::less(
+      const RootBlossom<edge_weight> &blossom0,
+      const RootBlossom<edge_weight> &blossom1)
+    {
+      const edge_weight &dualVariable0 =
+        static_cast<const ParentBlossom<edge_weight> &>(blossom0.rootChild)
+          .dualVariable;
+      const edge_weight &dualVariable1 =
+        static_cast<const ParentBlossom<edge_weight> &>(blossom1.rootChild)
+          .dualVariable;
+      return
+        dualVariable0 < dualVariable1
+          || (!(dualVariable1 < dualVariable0)
+                && blossom0.constructionIndex < blossom1.constructionIndex);
+    }
+    template <typename edge_weight>
+    inline std::size_t &InnerRootBlossomOrder<edge_weight>::position(
+      RootBlossom<edge_weight> &blossom)
+    {
+      return blossom.heapPosition;
+    }
   }
 }
 
@@ -1,6 +1,8 @@
 #ifndef ROOTBLOSSOMSIG_H
 #define ROOTBLOSSOMSIG_H
 
+#include <cstddef>
+#include <limits>
 #include <vector>
 
 #include "types.h"
@@ -30,11 +32,12 @@ namespace matching
        * between a pair of OUTER RootBlossoms. For each other OUTER RootBlossom,
        * this vector holds a pointer to the Vertex in this RootBlossom that is
        * part of the minimum edge between them. The position in the vector is
-       * indexed by the other RootBlossom's baseVertex's vertexIndex.
+       * indexed by the other RootBlossom's baseVertex's vertexIndex. The
+       * vector is a row of Graph::rootBlossomMinOuterEdges.
        *
        * Only valid during the augmentation step.
        */
-      std::vector<Vertex<edge_weight> *> minOuterEdges;
+      Vertex<edge_weight> **const minOuterEdges;
       /**
        * If label is OUTER, this is the minimum resistance between this
        * RootBlossom and another OUTER RootBlossom, unless there are none, in
@@ -68,10 +71,23 @@ namespace matching
        * Only valid during the augmentation step.
        */
       Vertex<edge_weight> *labeledVertex;
+      /**
+       * The position of this RootBlossom in Graph::outerRootBlossomHeap or
+       * Graph::innerRootBlossomHeap, according to label, or
+       * std::numeric_limits<std::size_t>::max() if it is in neither.
+       */
+      std::size_t heapPosition{ std::numeric_limits<std::size_t>::max() };
+      /**
+       * The value of Graph::rootBlossomConstructionCount when this RootBlossom
+       * was constructed. RootBlossoms are appended to Graph::rootBlossomPool
+       * and never unhidden, so this follows the order of iteration over the
+       * pool, which the heaps use to break ties.
+       */
+      const std::size_t constructionIndex;
 
       RootBlossom(RootBlossom<edge_weight> &) = delete;
       RootBlossom(RootBlossom<edge_weight> &&) = delete;
-      RootBlossom(Vertex<edge_weight> &, vertex_index, Graph<edge_weight> &);
+      RootBlossom(Vertex<edge_weight> &, Graph<edge_weight> &);
       template <class PathIterator>
       RootBlossom(PathIterator, PathIterator, Graph<edge_weight> &);
       RootBlossom(
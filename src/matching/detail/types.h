@@ -1,14 +1,21 @@
 #ifndef MATCHINGDETAILTYPES_H
 #define MATCHINGDETAILTYPES_H
 
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include <tournament/tournament.h>
 #include <utility/dynamicuint.h>
 #include <utility/uinttypes.h>
 
+#include "resistance.h"
+
 namespace matching
 {
   namespace detail
@@ -24,17 +31,81 @@ namespace matching
       LABEL_OUTER, LABEL_ZERO, LABEL_INNER, LABEL_FREE
     };
 
+    /**
+     * An iterator over the pieces of one element of a DynamicUintVector. The
+     * pieces of an element are stored resistance::blockSize words apart.
+     */
+    template <typename T>
+    class StridedIterator
+    {
+    public:
+      typedef std::bidirectional_iterator_tag iterator_category;
+      typedef std::remove_const_t<T> value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef T *pointer;
+      typedef T &reference;
+
+      StridedIterator() = default;
+      explicit StridedIterator(T *const piece_) : piece(piece_) { }
+
+      T &operator*() const
+      {
+        return *piece;
+      }
+
+      StridedIterator<T> &operator++() &
+      {
+        piece += resistance::blockSize;
+        return *this;
+      }
+      StridedIterator<T> operator++(int) &
+      {
+        const StridedIterator<T> result = *this;
+        ++*this;
+        return result;
+      }
+      StridedIterator<T> &operator--() &
+      {
+        piece -= resistance::blockSize;
+        return *this;
+      }
+      StridedIterator<T> operator--(int) &
+      {
+        const StridedIterator<T> result = *this;
+        --*this;
+        return result;
+      }
+
+      bool operator==(const StridedIterator<T> &that) const
+      {
+        return piece == that.piece;
+      }
+
+    private:
+      T *piece{ };
+    };
+
     /**
      * A class acting as a vector of multiple DynamicUints that all have the
      * same size, but using only a single block of memory.
+     *
+     * The elements are stored in blocks of resistance::blockSize. Within a
+     * block, piece k of every element is stored contiguously, so that the
+     * resistance kernels can process a block with one vector load per piece,
+     * while the pieces of a single element remain close together.
      */
-    class DynamicUintVector : private std::vector<std::uintmax_t>
+    class DynamicUintVector
     {
     public:
-      using std::vector<std::uintmax_t>::size_type;
+      typedef std::vector<std::uintmax_t>::size_type size_type;
 
-      typedef utility::uinttypes::DynamicUintView<iterator> view;
-      typedef utility::uinttypes::DynamicUintView<const_iterator> const_view;
+      typedef
+        utility::uinttypes::DynamicUintView<StridedIterator<std::uintmax_t>>
+        view;
+      typedef
+        utility::uinttypes::DynamicUintView<
+          StridedIterator<const std::uintmax_t>>
+        const_view;
 
       typedef view reference;
 
@@ -42,69 +113,372 @@ namespace matching
       /**
        * Create a DynamicUintVector containing size copies of value.
        */
-      DynamicUintVector(size_type size, const const_view value)
+      template <typename Iterator>
+      DynamicUintVector(
+        size_type size,
+        const utility::uinttypes::DynamicUintView<Iterator> value)
       {
         while (size--)
         {
           push_back(value);
         }
       }
+      DynamicUintVector(
+          const size_type size,
+          const utility::uinttypes::DynamicUint &value)
+        : DynamicUintVector(
+            size,
+            utility::uinttypes::DynamicUint::const_view{ value }) { }
 
       view operator[](const size_type index) &
       {
+        assert(index < elementCount);
+        std::uintmax_t *const element =
+          pieces.data() + resistance::offset(index, elementSize);
         return
           view(
-            begin() + index * elementSize,
-            begin() + (index + 1u) * elementSize);
+            StridedIterator<std::uintmax_t>(element),
+            StridedIterator<std::uintmax_t>(
+              element + elementSize * resistance::blockSize));
       }
       const_view operator[](const size_type index) const &
       {
+        assert(index < elementCount);
+        const std::uintmax_t *const element =
+          pieces.data() + resistance::offset(index, elementSize);
         return
           const_view(
-            begin() + index * elementSize,
-            begin() + (index + 1u) * elementSize);
+            StridedIterator<const std::uintmax_t>(element),
+            StridedIterator<const std::uintmax_t>(
+              element + elementSize * resistance::blockSize));
       }
 
       template <typename Iterator>
       void push_back(const utility::uinttypes::DynamicUintView<Iterator> view) &
       {
-        for (
-          auto iterator = view.begin();
-          iterator != view.end();
-          ++iterator)
-        {
-          std::vector<std::uintmax_t>::push_back(*iterator);
-        }
-        if (elementSize)
+        if (!elementSize)
         {
-          assert(!(size() % elementSize));
+          elementSize = std::distance(view.begin(), view.end());
         }
-        else
+        assert(
+          size_type(std::distance(view.begin(), view.end())) == elementSize);
+        if (!(elementCount % resistance::blockSize))
         {
-          elementSize = size();
+          // Add a block, keeping the padding at the end.
+          if (
+            elementSize
+              > (pieces.max_size() - pieces.size()) / resistance::blockSize)
+          {
+            throw std::length_error("");
+          }
+          pieces.resize(
+            (elementCount + resistance::blockSize) * elementSize
+              + resistance::blockSize);
         }
+        ++elementCount;
+        (*this)[elementCount - 1u] = view;
       }
       void push_back(const utility::uinttypes::DynamicUint &value) &
       {
         push_back(utility::uinttypes::DynamicUint::const_view{ value });
       }
 
+      size_type size() const
+      {
+        return elementCount;
+      }
+
+      /**
+       * The number of std::uintmax_t pieces in each element.
+       */
+      size_type pieceSize() const
+      {
+        return elementSize;
+      }
+      /**
+       * Piece k of element i is stored at
+       * data()[resistance::offset(i, pieceSize()) + k * resistance::blockSize].
+       */
+      std::uintmax_t *data() &
+      {
+        return pieces.data();
+      }
+      const std::uintmax_t *data() const &
+      {
+        return pieces.data();
+      }
+
+      std::size_t getAllocatedBytes() const
+      {
+        return pieces.capacity() * sizeof(std::uintmax_t);
+      }
+
     private:
-      std::vector<std::uintmax_t>::size_type elementSize{ };
+      /**
+       * The blocks, followed by resistance::blockSize words of padding, so
+       * that the end iterator of every element points into the allocation.
+       */
+      std::vector<std::uintmax_t> pieces;
+      size_type elementCount{ };
+      size_type elementSize{ };
     };
 
+    /**
+     * The number of bytes in a cache line. The rows of edge weight matrices
+     * are padded to whole cache lines and start on cache line boundaries.
+     */
+    constexpr std::size_t cacheLineSize = 64u;
+
+    /**
+     * The smallest number of elements of type T spanning a whole number of
+     * cache lines.
+     */
+    template <typename T>
+    constexpr std::size_t elementsPerCacheLines =
+      cacheLineSize / std::gcd(cacheLineSize, sizeof(T));
+
+    /**
+     * Return the smallest index less than elementsPerCacheLines<T> such that
+     * data + index is aligned to a cache line, or zero if there is none.
+     */
+    template <typename T>
+    std::size_t cacheLineOffset(const T *const data)
+    {
+      for (std::size_t index{ }; index < elementsPerCacheLines<T>; ++index)
+      {
+        if (
+          !(reinterpret_cast<std::uintptr_t>(data + index) % cacheLineSize))
+        {
+          return index;
+        }
+      }
+      return 0u;
+    }
+
+    /**
+     * Round value up to a multiple of unit, throwing std::length_error on
+     * overflow.
+     */
+    template <typename T>
+    T roundUp(const T value, const std::size_t unit)
+    {
+      const T result = (value + (unit - 1u)) / unit * unit;
+      if (result < value)
+      {
+        throw std::length_error("");
+      }
+      return result;
+    }
+
+    /**
+     * A square matrix of edge weights with a fixed capacity, stored in a
+     * single allocation. Each row is padded to a whole number of cache lines
+     * and starts on a cache line boundary, so that scanning a row touches
+     * only the lines holding its entries.
+     */
+    template <typename edge_weight>
+    class EdgeWeightMatrix
+    {
+    public:
+      typedef typename std::vector<edge_weight>::size_type size_type;
+
+      /**
+       * A pointer to the beginning of a row.
+       */
+      typedef edge_weight *row;
+
+      /**
+       * Create a capacity by capacity matrix with every entry equal to zero.
+       */
+      EdgeWeightMatrix(const size_type capacity, const edge_weight &zero)
+        : rowStride(roundUp(capacity, elementsPerCacheLines<edge_weight>))
+      {
+        if (
+          rowStride
+            && capacity
+              > (entries.max_size() - elementsPerCacheLines<edge_weight>)
+                / rowStride)
+        {
+          throw std::length_error("");
+        }
+        entries.assign(
+          capacity * rowStride + elementsPerCacheLines<edge_weight>,
+          zero);
+        start = cacheLineOffset(entries.data());
+      }
+
+      row operator[](const size_type index) &
+      {
+        assert(start + (index + 1u) * rowStride <= entries.size());
+        return entries.data() + start + index * rowStride;
+      }
+
+      std::size_t getAllocatedBytes() const
+      {
+        return entries.capacity() * sizeof(edge_weight);
+      }
+
+    private:
+      std::vector<edge_weight> entries;
+      /**
+       * The number of elements from the beginning of one row to the next.
+       */
+      size_type rowStride;
+      /**
+       * The position of row zero in entries.
+       */
+      size_type start;
+    };
+
+    /**
+     * The equivalent of EdgeWeightMatrix for DynamicUints. Each row is laid
+     * out like the data of a DynamicUintVector, so that the resistance
+     * kernels can stream over it.
+     */
+    class DynamicUintMatrix
+    {
+    public:
+      typedef std::vector<std::uintmax_t>::size_type size_type;
+
+      /**
+       * A view of one row of the matrix.
+       */
+      class row
+      {
+      public:
+        row(std::uintmax_t *const pieces_, const size_type elementSize_)
+          : pieces(pieces_), elementSize(elementSize_) { }
+
+        DynamicUintVector::view operator[](const size_type index) const
+        {
+          std::uintmax_t *const element =
+            pieces + resistance::offset(index, elementSize);
+          return
+            DynamicUintVector::view(
+              StridedIterator<std::uintmax_t>(element),
+              StridedIterator<std::uintmax_t>(
+                element + elementSize * resistance::blockSize));
+        }
+
+        /**
+         * The number of std::uintmax_t pieces in each element.
+         */
+        size_type pieceSize() const
+        {
+          return elementSize;
+        }
+        /**
+         * The row's pieces, in the layout described by
+         * DynamicUintVector::data().
+         */
+        std::uintmax_t *data() const
+        {
+          return pieces;
+        }
+
+      private:
+        std::uintmax_t *pieces;
+        size_type elementSize;
+      };
+
+      /**
+       * Create a capacity by capacity matrix with every entry equal to zero,
+       * with entries having as many pieces as zero.
+       */
+      DynamicUintMatrix(
+          const size_type capacity,
+          const utility::uinttypes::DynamicUint &zero)
+        : elementSize(
+            std::distance(
+              utility::uinttypes::DynamicUint::const_view{ zero }.begin(),
+              utility::uinttypes::DynamicUint::const_view{ zero }.end())),
+          rowStride(
+            roundUp(
+              capacity,
+              std::lcm(
+                resistance::blockSize,
+                elementsPerCacheLines<std::uintmax_t>)))
+      {
+        // Leave room for alignment, and for the end iterator of the last
+        // element of the last row.
+        constexpr size_type padding =
+          elementsPerCacheLines<std::uintmax_t> + resistance::blockSize;
+        if (
+          rowStride
+            && elementSize
+            && capacity
+              > (pieces.max_size() - padding) / rowStride / elementSize)
+        {
+          throw std::length_error("");
+        }
+        pieces.resize(capacity * rowStride * elementSize + padding);
+        start = cacheLineOffset(pieces.data());
+      }
+
+      row operator[](const size_type index) &
+      {
+        assert(
+          start + (index + 1u) * rowStride * elementSize <= pieces.size());
+        return
+          row(
+            pieces.data() + start + index * rowStride * elementSize,
+            elementSize);
+      }
+
+      std::size_t getAllocatedBytes() const
+      {
+        return pieces.capacity() * sizeof(std::uintmax_t);
+      }
+
+    private:
+      std::vector<std::uintmax_t> pieces;
+      size_type elementSize;
+      /**
+       * The number of elements from the beginning of one row to the next, a
+       * multiple of resistance::blockSize.
+       */
+      size_type rowStride;
+      /**
+       * The position of row zero in pieces.
+       */
+      size_type start;
+    };
+
+    /**
+     * Return the number of bytes of heap memory held by the container.
+     */
+    template <typename T>
+    std::size_t getAllocatedBytes(const std::vector<T> &container)
+    {
+      return container.capacity() * sizeof(T);
+    }
+    template <class Container>
+    auto getAllocatedBytes(const Container &container)
+      -> decltype(container.getAllocatedBytes())
+    {
+      return container.getAllocatedBytes();
+    }
+
     namespace
     {
+      template <typename edge_weight>
+      struct edge_weight_traits;
+
       /**
-       * Behavior that can be customized for specific edge_weight types.
+       * The behavior of edge_weight_traits for types without a specialized
+       * version.
        */
       template <typename edge_weight>
-      struct edge_weight_traits
+      struct basic_edge_weight_traits
       {
         /**
          * A vector of edge_weights.
          */
         typedef std::vector<edge_weight> vector;
+        /**
+         * A square matrix of edge_weights.
+         */
+        typedef EdgeWeightMatrix<edge_weight> matrix;
         /**
          * Add addend1 to addend0, and subtract subtrahend.
          */
@@ -116,11 +490,67 @@ namespace matching
           addend0 += addend1;
           addend0 -= subtrahend;
         }
+        /**
+         * For each index i in [begin, end) with candidates[i] nonzero, lower
+         * minResistances[i] to dualVariable + dualVariables[i] - edgeWeights[i]
+         * if that is strictly less, and set improved[i] to indicate whether it
+         * was.
+         */
+        static void updateMinResistances(
+          const edge_weight dualVariable,
+          const vector &dualVariables,
+          const typename matrix::row edgeWeights,
+          vector &minResistances,
+          const typename vector::size_type begin,
+          const typename vector::size_type end,
+          const unsigned char *const candidates,
+          unsigned char *const improved)
+        {
+          for (typename vector::size_type index = begin; index < end; ++index)
+          {
+            improved[index] = false;
+            if (candidates[index])
+            {
+              edge_weight resistance = dualVariable;
+              edge_weight_traits<edge_weight>::addSubtract(
+                resistance,
+                dualVariables[index],
+                edgeWeights[index]);
+              if (resistance < minResistances[index])
+              {
+                minResistances[index] = resistance;
+                improved[index] = true;
+              }
+            }
+          }
+        }
+      };
+      /**
+       * Behavior that can be customized for specific edge_weight types.
+       */
+      template <typename edge_weight>
+      struct edge_weight_traits : basic_edge_weight_traits<edge_weight> { };
+      /**
+       * The same as the generic version, but adding and subtracting in a
+       * single pass over the pieces.
+       */
+      template <std::size_t pieces>
+      struct edge_weight_traits<utility::uinttypes::uint<pieces>>
+        : basic_edge_weight_traits<utility::uinttypes::uint<pieces>>
+      {
+        static void addSubtract(
+          utility::uinttypes::uint<pieces> &addend0,
+          const utility::uinttypes::uint<pieces> addend1,
+          const utility::uinttypes::uint<pieces> subtrahend)
+        {
+          addend0.addSubtract(addend1, subtrahend);
+        }
       };
       template <>
       struct edge_weight_traits<utility::uinttypes::DynamicUint>
       {
         typedef DynamicUintVector vector;
+        typedef DynamicUintMatrix matrix;
         template <typename Iterator0, typename Iterator1, typename Iterator2>
         static void addSubtract(
           utility::uinttypes::DynamicUintView<Iterator0> addend0,
@@ -140,6 +570,45 @@ namespace matching
             addend1,
             subtrahend);
         }
+        /**
+         * The same as the generic version, but streaming over the blocks of
+         * the DynamicUintVectors. begin must be a multiple of
+         * resistance::blockSize.
+         */
+        template <typename Iterator>
+        static void updateMinResistances(
+          const utility::uinttypes::DynamicUintView<Iterator> dualVariable,
+          const DynamicUintVector &dualVariables,
+          const DynamicUintMatrix::row edgeWeights,
+          DynamicUintVector &minResistances,
+          const DynamicUintVector::size_type begin,
+          const DynamicUintVector::size_type end,
+          const unsigned char *const candidates,
+          unsigned char *const improved)
+        {
+          const utility::uinttypes::DynamicUint contiguousDualVariable{
+            dualVariable
+          };
+          assert(!(begin % resistance::blockSize));
+          assert(begin <= end);
+          assert(end <= dualVariables.size());
+          assert(end <= minResistances.size());
+          assert(dualVariables.pieceSize() == edgeWeights.pieceSize());
+          assert(minResistances.pieceSize() == edgeWeights.pieceSize());
+          const std::size_t offset =
+            resistance::offset(begin, edgeWeights.pieceSize());
+          resistance::updateMins(
+            &*utility::uinttypes::DynamicUint::const_view{
+              contiguousDualVariable
+            }.begin(),
+            dualVariables.data() + offset,
+            edgeWeights.data() + offset,
+            minResistances.data() + offset,
+            edgeWeights.pieceSize(),
+            end - begin,
+            candidates + begin,
+            improved + begin);
+        }
       };
     }
   }
@@ -21,13 +21,18 @@ namespace matching
         const vertex_index vertexIndex_,
         Graph<edge_weight> &graph)
       : Blossom<edge_weight>(
-          graph.rootBlossomPool.construct(*this, vertexIndex_, graph),
+          graph.rootBlossomPool.construct(*this, graph),
           *this,
           *this,
           true),
+        edgeWeights(graph.vertexEdgeWeights[vertexIndex_]),
         dualVariable(graph.vertexDualVariables[vertexIndex_]),
-        minOuterEdgeResistance(graph.aboveMaxEdgeWeight),
-        vertexIndex(vertexIndex_) { }
+        minOuterEdgeResistance(
+          graph.vertexMinOuterEdgeResistances[vertexIndex_]),
+        vertexIndex(vertexIndex_)
+    {
+      minOuterEdgeResistance = graph.aboveMaxEdgeWeight;
+    }
 
     /**
      * Determine the resistance between two Vertexes in different RootBlossoms.
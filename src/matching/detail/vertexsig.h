@@ -22,8 +22,9 @@ namespace matching
     {
       /**
        * The weights of the edges to the other vertices, indexed by vertexIndex.
+       * This is the Vertex's row of graph.vertexEdgeWeights.
        */
-      typename edge_weight_traits<edge_weight>::vector edgeWeights;
+      typename edge_weight_traits<edge_weight>::matrix::row edgeWeights;
       typename edge_weight_traits<edge_weight>::vector::reference dualVariable;
       /**
        * If this Vertex is not OUTER, this is the minimum resistance of edges
@@ -32,7 +33,8 @@ namespace matching
        *
        * Only valid during augmentation.
        */
-      edge_weight minOuterEdgeResistance;
+      typename edge_weight_traits<edge_weight>::vector::reference
+        minOuterEdgeResistance;
       /**
        * If this Vertex is not OUTER, this is the Vertex associated with the
        * minimum-resistance edge to an OUTER Vertex, assuming such a Vertex
@@ -46,6 +48,17 @@ namespace matching
        * Vertexes.
        */
       Vertex<edge_weight> *nextVertex{ };
+      /**
+       * The vertexIndexes of the Vertexes joined to this Vertex by edges of
+       * nonzero weight, in increasing order. Only used by filtered outer-outer
+       * scans, and only valid if !neighborsStale.
+       */
+      std::vector<vertex_index> neighbors;
+      /**
+       * Set when an edge weight of this Vertex changes, so that neighbors is
+       * rebuilt before the next filtered outer-outer scan.
+       */
+      bool neighborsStale{ true };
       const vertex_index vertexIndex;
 
       Vertex(vertex_index, Graph<edge_weight> &);
@@ -0,0 +1,124 @@
+#ifndef MATCHINGSTATS_H
+#define MATCHINGSTATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+/**
+ * The statistics are only gathered if the build defines MATCHING_STATS (see
+ * the matching_stats flag in the Makefile). Otherwise these macros expand to
+ * nothing, and the counters remain zero.
+ */
+#ifdef MATCHING_STATS
+#define MATCHING_STATS_COUNT(stats, counter) ++(stats).counter
+#define MATCHING_STATS_MAX(stats, counter, value) \
+  (stats).counter = std::max<std::uint_least64_t>((stats).counter, value)
+#define MATCHING_STATS_TIME(stats, timer) \
+  const ::matching::ScopedTimer timer##Timer{ (stats).timer }
+#else
+#define MATCHING_STATS_COUNT(stats, counter)
+#define MATCHING_STATS_MAX(stats, counter, value)
+#define MATCHING_STATS_TIME(stats, timer)
+#endif
+
+namespace matching
+{
+  /**
+   * Counters and timers describing the work done by a Computer, accumulated
+   * over all its computeMatching() calls. The timers are in nanoseconds, and
+   * nested phases are included in the enclosing phase's time.
+   */
+  struct Stats
+  {
+    std::uint_least64_t computations{ };
+    std::uint_least64_t augmentations{ };
+    std::uint_least64_t labelings{ };
+    std::uint_least64_t blossomShrinks{ };
+    std::uint_least64_t blossomExpansions{ };
+    std::uint_least64_t dualAdjustments{ };
+    std::uint_least64_t innerOuterEdgeUpdates{ };
+    /**
+     * The most memory held by the Computer's graph after any computation, in
+     * bytes.
+     */
+    std::uint_least64_t peakAllocatedBytes{ };
+
+    std::uint_least64_t computationNanoseconds{ };
+    std::uint_least64_t edgeInitializationNanoseconds{ };
+    std::uint_least64_t dualAdjustmentNanoseconds{ };
+    std::uint_least64_t blossomShrinkNanoseconds{ };
+    std::uint_least64_t blossomExpansionNanoseconds{ };
+    std::uint_least64_t innerOuterEdgeUpdateNanoseconds{ };
+
+    Stats &operator+=(const Stats &that) &
+    {
+      computations += that.computations;
+      augmentations += that.augmentations;
+      labelings += that.labelings;
+      blossomShrinks += that.blossomShrinks;
+      blossomExpansions += that.blossomExpansions;
+      dualAdjustments += that.dualAdjustments;
+      innerOuterEdgeUpdates += that.innerOuterEdgeUpdates;
+      peakAllocatedBytes =
+        std::max(peakAllocatedBytes, that.peakAllocatedBytes);
+      computationNanoseconds += that.computationNanoseconds;
+      edgeInitializationNanoseconds += that.edgeInitializationNanoseconds;
+      dualAdjustmentNanoseconds += that.dualAdjustmentNanoseconds;
+      blossomShrinkNanoseconds += that.blossomShrinkNanoseconds;
+      blossomExpansionNanoseconds += that.blossomExpansionNanoseconds;
+      innerOuterEdgeUpdateNanoseconds += that.innerOuterEdgeUpdateNanoseconds;
+      return *this;
+    }
+  };
+
+  /**
+   * Print the Stats as name=value pairs, one phase per line.
+   */
+  inline std::ostream &operator<<(std::ostream &ostream, const Stats &stats)
+  {
+    return
+      ostream
+        << "computations=" << stats.computations
+        << " time=" << stats.computationNanoseconds << "ns\n"
+        << "augmentations=" << stats.augmentations
+        << " labelings=" << stats.labelings << '\n'
+        << "edge initialization time="
+        << stats.edgeInitializationNanoseconds << "ns\n"
+        << "dual adjustments=" << stats.dualAdjustments
+        << " time=" << stats.dualAdjustmentNanoseconds << "ns\n"
+        << "blossom shrinks=" << stats.blossomShrinks
+        << " time=" << stats.blossomShrinkNanoseconds << "ns\n"
+        << "blossom expansions=" << stats.blossomExpansions
+        << " time=" << stats.blossomExpansionNanoseconds << "ns\n"
+        << "inner-outer edge updates=" << stats.innerOuterEdgeUpdates
+        << " time=" << stats.innerOuterEdgeUpdateNanoseconds << "ns\n"
+        << "peak graph allocation=" << stats.peakAllocatedBytes << "B\n";
+  }
+
+  /**
+   * Add the time between construction and destruction to a timer.
+   */
+  class ScopedTimer
+  {
+  public:
+    explicit ScopedTimer(std::uint_least64_t &nanoseconds_)
+      : nanoseconds(nanoseconds_), start(std::chrono::steady_clock::now()) { }
+    ScopedTimer(const ScopedTimer &) = delete;
+
+    ~ScopedTimer()
+    {
+      nanoseconds +=
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - start
+        ).count();
+    }
+
+  private:
+    std::uint_least64_t &nanoseconds;
+    const std::chrono::steady_clock::time_point start;
+  };
+}
+
+#endif
@@ -15,7 +15,14 @@ a(swisssystems::burstein::matching_computer::edge_weight)
 #define MATCHING_EDGE_WEIGHTS_DUTCH(a)
 #else
 #define MATCHING_EDGE_WEIGHTS_DUTCH(a) \
-a(swisssystems::dutch::matching_computer::edge_weight)
+a(swisssystems::dutch::matching_computer::edge_weight) \
+a(swisssystems::dutch::fixed_width_matching_computer<1>::edge_weight) \
+a(swisssystems::dutch::fixed_width_matching_computer<2>::edge_weight) \
+a(swisssystems::dutch::fixed_width_matching_computer<3>::edge_weight) \
+a(swisssystems::dutch::fixed_width_matching_computer<4>::edge_weight)
+static_assert(
+  swisssystems::dutch::maxFixedWidthEdgeWeightPieces == 4u,
+  "MATCHING_EDGE_WEIGHTS_DUTCH must list every fixed width.");
 #endif
 
 // This macro is called in the cpp files of the matching code to instantiate the
@@ -3,6 +3,7 @@
 #include <iterator>
 #include <limits>
 #include <list>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -11,6 +12,8 @@
 
 #include <matching/computer.h>
 #include <tournament/tournament.h>
+#include <utility/bitmatrix.h>
+#include <utility/threadpool.h>
 #include <utility/typesizes.h>
 #include <utility/uintstringconversion.h>
 #include <utility/uinttypes.h>
@@ -35,8 +38,10 @@ namespace swisssystems
           const tournament::player_index player_index : tournament.playersByRank
         )
         {
-          const tournament::Player &player = tournament.players[player_index];
-          if (!player.matches.size() || player.matches[0].participatedInPairing)
+          if (
+            !tournament.matchHistory.getMatchCount(player_index)
+              || tournament.matchHistory
+                   .getParticipatedInPairing(0u, player_index))
           {
             ++rankBound;
           }
@@ -51,7 +56,9 @@ namespace swisssystems
             tournament::Player &player = tournament.players[player_index];
             player.accelerations.push_back(tournament.pointsForWin);
             if (
-              !player.matches.size() || player.matches[0].participatedInPairing)
+              !tournament.matchHistory.getMatchCount(player_index)
+                || tournament.matchHistory
+                     .getParticipatedInPairing(0u, player_index))
             {
               rankBound -= 2;
               if (rankBound <= 1u)
@@ -131,16 +138,31 @@ namespace swisssystems
             : tournament.pointsForForfeitLoss;
       }
 
-      points_product calculateSonnebornBerger(
+      /**
+       * The tiebreak scores of a player, before they are multiplied by the
+       * player's score.
+       */
+      struct Tiebreaks
+      {
+        points_product sonnebornBerger{ };
+        points_product buchholz{ };
+        points_product median{ };
+      };
+
+      /**
+       * Compute the Sonneborn-Berger, Buchholz, and Median tiebreaks of the
+       * player in a single pass over the player's matches.
+       */
+      Tiebreaks calculateTiebreaks(
         const tournament::Player &player,
         const tournament::Tournament &tournament,
         const std::vector<adjusted_score> &adjustedScores)
       {
+        Tiebreaks result;
         if (!player.isValid)
         {
-          return 0;
+          return result;
         }
-        points_product result{ };
         const adjusted_score futureVirtualPoints =
           adjusted_score(tournament.playedRounds - 1u)
             * tournament.pointsForDraw;
@@ -166,85 +188,8 @@ namespace swisssystems
                       + " points per draw."));
         }
 
-        tournament::round_index roundIndex{ };
-        for (const tournament::Match &match : player.matches)
-        {
-          if (roundIndex >= tournament.playedRounds)
-          {
-            break;
-          }
-          if (match.gameWasPlayed)
-          {
-            const points_product addend =
-              points_product{ adjustedScores[match.opponent] }
-                * tournament.getPoints(player, match);
-            result += addend;
-            if (
-              result < addend
-                || (adjustedScores[match.opponent]
-                      && addend / adjustedScores[match.opponent]
-                          < tournament.getPoints(player, match)))
-            {
-              assert(
-                tournament.playedRounds > tournament::maxRounds
-                  || tournament.pointsForWin > tournament::maxPoints
-                  || tournament.pointsForDraw > tournament::maxPoints
-                  || tournament.pointsForLoss > tournament::maxPoints
-                  || tournament.pointsForForfeitLoss > tournament::maxPoints
-                  || tournament.pointsForZeroPointBye > tournament::maxPoints
-                  || tournament.pointsForPairingAllocatedBye
-                      > tournament::maxPoints);
-              throw tournament::BuildLimitExceededException(
-                "This build supports at most "
-                  + (tournament.playedRounds > tournament::maxRounds
-                      ? utility::uintstringconversion
-                            ::toString(tournament::maxRounds)
-                          + " rounds."
-                      : utility::uintstringconversion
-                            ::toString(tournament::maxPoints, 1)
-                          + "points per match."));
-            }
-          }
-          else
-          {
-            const adjusted_score virtualScore =
-              virtualPoints
-                + getVirtualOpponentScore(player, match, tournament);
-            const points_product scaledScore =
-              points_product{ tournament.getPoints(player, match) }
-                * virtualScore;
-            result += scaledScore;
-            if (
-              result < scaledScore
-                || virtualScore < virtualPoints
-                || (virtualScore
-                      && scaledScore / virtualScore
-                          < tournament.getPoints(player, match)))
-            {
-              assert(
-                tournament.playedRounds > tournament::maxRounds
-                  || tournament.pointsForWin > tournament::maxPoints
-                  || tournament.pointsForDraw > tournament::maxPoints
-                  || tournament.pointsForLoss > tournament::maxPoints
-                  || tournament.pointsForForfeitLoss > tournament::maxPoints
-                  || tournament.pointsForZeroPointBye > tournament::maxPoints
-                  || tournament.pointsForPairingAllocatedBye
-                      > tournament::maxPoints);
-              throw tournament::BuildLimitExceededException(
-                "This build supports at most "
-                  + (tournament.playedRounds > tournament::maxRounds
-                      ? utility::uintstringconversion
-                            ::toString(tournament::maxRounds)
-                          + " rounds."
-                      : utility::uintstringconversion
-                            ::toString(tournament::maxPoints, 1)
-                          + " points per match."));
-            }
-          }
-          virtualPoints += tournament.getPoints(player, match);
-          if (
-            virtualPoints < tournament.getPoints(player, match)
-              && virtualPoints >= tournament.pointsForDraw)
+        const auto throwMatchPointsLimitExceeded =
+          [&tournament]()
           {
             assert(
               tournament.playedRounds > tournament::maxRounds
@@ -263,153 +208,84 @@ namespace swisssystems
                         + " rounds."
                     : utility::uintstringconversion
                           ::toString(tournament::maxPoints, 1)
-                        + "points per match."));
-          }
-          virtualPoints -= tournament.pointsForDraw;
-          ++roundIndex;
-        }
-        return result;
-      }
-
-      points_product calculateBuchholzTiebreak(
-        const tournament::Player &player,
-        const tournament::Tournament &tournament,
-        const std::vector<adjusted_score> &adjustedScores,
-        const bool median = false)
-      {
-        if (!player.isValid || (median && tournament.playedRounds <= 2))
-        {
-          return 0;
-        }
-        points_product result{ };
-        const adjusted_score futureVirtualPoints =
-          adjusted_score(tournament.playedRounds - 1u)
-            * tournament.pointsForDraw;
-        adjusted_score virtualPoints =
-          futureVirtualPoints + player.acceleration(tournament);
-        if (
-          virtualPoints < futureVirtualPoints
-            || (tournament.playedRounds > 1u
-                  && futureVirtualPoints / (tournament.playedRounds - 1u)
-                      < tournament.pointsForDraw))
-        {
-          assert(
-            tournament.playedRounds > tournament::maxRounds
-              || tournament.pointsForDraw > tournament::maxPoints);
-          throw tournament::BuildLimitExceededException(
-            "This build supports at most "
-              + (tournament.playedRounds > tournament::maxRounds
-                  ? utility::uintstringconversion
-                        ::toString(tournament::maxRounds)
-                      + " rounds."
-                  : utility::uintstringconversion
-                        ::toString(tournament::maxPoints, 1)
-                      + " points per draw."));
-        }
+                        + " points per match."));
+          };
 
         adjusted_score min =
           std::numeric_limits<adjusted_score>::max();
         adjusted_score max{ };
 
         tournament::round_index roundIndex{ };
-        for (const tournament::Match &match : player.matches)
+        for (
+          const tournament::Match &match : tournament.matchHistory[player.id])
         {
           if (roundIndex >= tournament.playedRounds)
           {
             break;
           }
-          adjusted_score adjustment;
+          const tournament::points points =
+            tournament.getPoints(player, match);
+
+          // The adjusted score of the opponent, or of the virtual opponent
+          // for an unplayed game.
+          adjusted_score opponentScore;
           if (match.gameWasPlayed)
           {
-            adjustment = adjustedScores[match.opponent];
+            opponentScore = adjustedScores[match.opponent];
           }
           else
           {
-            adjustment =
+            opponentScore =
               virtualPoints
                 + getVirtualOpponentScore(player, match, tournament);
-            if (adjustment < virtualPoints)
+            if (opponentScore < virtualPoints)
             {
-              assert(
-                tournament.playedRounds > tournament::maxRounds
-                  || tournament.pointsForWin > tournament::maxPoints
-                  || tournament.pointsForDraw > tournament::maxPoints
-                  || tournament.pointsForLoss > tournament::maxPoints
-                  || tournament.pointsForForfeitLoss > tournament::maxPoints
-                  || tournament.pointsForZeroPointBye > tournament::maxPoints
-                  || tournament.pointsForPairingAllocatedBye
-                      > tournament::maxPoints);
-              throw tournament::BuildLimitExceededException(
-                "This build supports at most "
-                  + (tournament.playedRounds > tournament::maxRounds
-                      ? utility::uintstringconversion
-                            ::toString(tournament::maxRounds)
-                          + " rounds."
-                      : utility::uintstringconversion
-                            ::toString(tournament::maxPoints, 1)
-                          + " points per match."));
+              throwMatchPointsLimitExceeded();
             }
           }
-          result += adjustment;
-          if (result < adjustment)
+
+          const points_product addend =
+            points_product{ opponentScore } * points;
+          result.sonnebornBerger += addend;
+          if (
+            result.sonnebornBerger < addend
+              || (opponentScore && addend / opponentScore < points))
           {
-            assert(
-              tournament.playedRounds > tournament::maxRounds
-                || tournament.pointsForWin > tournament::maxPoints
-                || tournament.pointsForDraw > tournament::maxPoints
-                || tournament.pointsForLoss > tournament::maxPoints
-                || tournament.pointsForForfeitLoss > tournament::maxPoints
-                || tournament.pointsForZeroPointBye > tournament::maxPoints
-                || tournament.pointsForPairingAllocatedBye
-                    > tournament::maxPoints);
-            throw tournament::BuildLimitExceededException(
-              "This build supports at most "
-                + (tournament.playedRounds > tournament::maxRounds
-                    ? utility::uintstringconversion
-                          ::toString(tournament::maxRounds)
-                        + " rounds."
-                    : utility::uintstringconversion
-                          ::toString(tournament::maxPoints, 1)
-                        + " points per match."));
+            throwMatchPointsLimitExceeded();
           }
-          min = std::min(min, adjustment);
-          max = std::max(max, adjustment);
 
-          virtualPoints += tournament.getPoints(player, match);
+          result.buchholz += opponentScore;
+          if (result.buchholz < opponentScore)
+          {
+            throwMatchPointsLimitExceeded();
+          }
+          min = std::min(min, opponentScore);
+          max = std::max(max, opponentScore);
+
+          virtualPoints += points;
           if (
-            virtualPoints < tournament.getPoints(player, match)
+            virtualPoints < points
               && virtualPoints >= tournament.pointsForDraw)
           {
-            assert(
-              tournament.playedRounds > tournament::maxRounds
-                || tournament.pointsForWin > tournament::maxPoints
-                || tournament.pointsForDraw > tournament::maxPoints
-                || tournament.pointsForLoss > tournament::maxPoints
-                || tournament.pointsForForfeitLoss > tournament::maxPoints
-                || tournament.pointsForZeroPointBye > tournament::maxPoints
-                || tournament.pointsForPairingAllocatedBye
-                    > tournament::maxPoints);
-            throw tournament::BuildLimitExceededException(
-              "This build supports at most "
-                + (tournament.playedRounds > tournament::maxRounds
-                    ? utility::uintstringconversion
-                          ::toString(tournament::maxRounds)
-                        + " rounds."
-                    : utility::uintstringconversion
-                          ::toString(tournament::maxPoints, 1)
-                        + "points per match."));
+            throwMatchPointsLimitExceeded();
           }
           virtualPoints -= tournament.pointsForDraw;
           ++roundIndex;
         }
-        if (median)
+        if (tournament.playedRounds > 2u)
         {
-          result -= min;
-          result -= max;
+          result.median = result.buchholz;
+          result.median -= min;
+          result.median -= max;
         }
         return result;
       }
 
+      /**
+       * The number of players from which the players are sorted in parallel.
+       */
+      constexpr std::size_t parallelSortThreshold = 1024u;
+
       /**
        * A class holding a player's accelerated score, rank index, and tiebreak
        * scores, used to order the players within a scoregroup (including a
@@ -426,16 +302,11 @@ namespace swisssystems
         MetricScores(
             const tournament::Player &player,
             const tournament::Tournament &tournament,
-            const std::vector<adjusted_score> &adjustedScores)
+            const Tiebreaks &tiebreaks)
           : playerScore(player.scoreWithAcceleration(tournament)),
-            sonnebornBerger(
-              calculateSonnebornBerger(player, tournament, adjustedScores)),
-            buchholzTiebreak(
-              calculateBuchholzTiebreak(player, tournament, adjustedScores)),
-            medianTiebreak(
-              calculateBuchholzTiebreak(player, tournament, adjustedScores, true
-              )
-            ),
+            sonnebornBerger(tiebreaks.sonnebornBerger),
+            buchholzTiebreak(tiebreaks.buchholz),
+            medianTiebreak(tiebreaks.median),
             rankIndex(player.rankIndex)
         {
           if (
@@ -528,13 +399,12 @@ namespace swisssystems
       matching_computer::edge_weight computeEdgeWeight(
         const tournament::Player &player0,
         const tournament::Player &player1,
-        const std::vector<std::unordered_set<tournament::player_index>>
-          &forbiddenPairs,
+        const utility::bitmatrix::BitMatrix &forbiddenPairs,
         bool sameScoreGroup,
         bool useDueColor)
       {
         return
-          forbiddenPairs[player0.id].count(player1.id)
+          forbiddenPairs.test(player0.id, player1.id)
               || (player0.absoluteColorPreference()
                     && player1.absoluteColorPreference()
                     && player0.colorPreference == player1.colorPreference)
@@ -617,7 +487,7 @@ namespace swisssystems
         const std::vector<MetricScores> &metricScores)
       {
         const tournament::Color result =
-          choosePlayerNeutralColor(player, opponent);
+          choosePlayerNeutralColor(player, opponent, tournament);
         return
           result == tournament::COLOR_NONE
             ? player.colorPreference == tournament::COLOR_NONE
@@ -700,7 +570,7 @@ namespace swisssystems
      * @throws NoValidPairingExists if no valid pairing exists.
      */
     std::list<Pairing> computeMatching(
-      tournament::Tournament &&tournament,
+      const tournament::Tournament &tournament,
       std::ostream *const ostream)
     {
       // Compute tiebreak scores for each player, and sort them into scoregroups
@@ -709,31 +579,52 @@ namespace swisssystems
       std::vector<adjusted_score> adjustedScores;
       // We add forbidden pairs due to previous pairings below
       auto forbiddenPairs = tournament.resolveForbiddenPairs(tournament.playedRounds);
-      for (tournament::Player &player : tournament.players)
+      for (const tournament::Player &player : tournament.players)
       {
         adjusted_score adjustedScore{ };
         if (player.isValid)
         {
-          if (player.matches.size() <= tournament.playedRounds)
+          if (
+            tournament.matchHistory.getMatchCount(player.id)
+              <= tournament.playedRounds)
           {
             sortedPlayers.push_back(&player);
           }
           adjustedScore = player.acceleration(tournament);
           tournament::round_index matchIndex{ };
-          for (const tournament::Match &match : player.matches)
+          for (
+            const tournament::Match &match
+              : tournament.matchHistory[player.id])
           {
             if (matchIndex++ < tournament.playedRounds)
             {
               adjustedScore += getAdjustedPoints(player, match, tournament);
             }
-            if (match.gameWasPlayed)
-            {
-              forbiddenPairs[player.id].insert(match.opponent);
-            }
           }
         }
         adjustedScores.push_back(adjustedScore);
       }
+      const tournament::MatchHistory &matchHistory = tournament.matchHistory;
+      for (
+        tournament::round_index round{ };
+        round < matchHistory.getRoundCount();
+        ++round)
+      {
+        for (
+          tournament::player_index playerIndex{ };
+          playerIndex < matchHistory.getPlayerCount();
+          ++playerIndex)
+        {
+          if (
+            tournament.players[playerIndex].isValid
+              && matchHistory.getGameWasPlayed(round, playerIndex))
+          {
+            forbiddenPairs.set(
+              playerIndex,
+              matchHistory.getOpponent(round, playerIndex));
+          }
+        }
+      }
 
       if (
         sortedPlayers.size() - (sortedPlayers.size() & 1u)
@@ -745,14 +636,55 @@ namespace swisssystems
             + " players.");
       }
 
+      // Each player's tiebreaks are written by a single task, so the results
+      // do not depend on the number of threads.
+      const std::unique_ptr<utility::threadpool::ThreadPool> threadPool{
+        PAIRING_THREADS > 1
+          ? std::make_unique<utility::threadpool::ThreadPool>(PAIRING_THREADS)
+          : nullptr
+      };
+      std::vector<Tiebreaks> tiebreaks(tournament.players.size());
+      const auto computeTiebreaks =
+        [&tiebreaks, &tournament, &adjustedScores](
+          const std::size_t playerIndex,
+          std::size_t)
+        {
+          tiebreaks[playerIndex] =
+            calculateTiebreaks(
+              tournament.players[playerIndex],
+              tournament,
+              adjustedScores);
+        };
+      if (threadPool)
+      {
+        threadPool->run(tournament.players.size(), computeTiebreaks);
+      }
+      else
+      {
+        for (
+          std::size_t playerIndex{ };
+          playerIndex < tournament.players.size();
+          ++playerIndex)
+        {
+          computeTiebreaks(playerIndex, 0u);
+        }
+      }
+
       std::vector<MetricScores> metricScores;
-      for (const tournament::Player &player : tournament.players)
+      for (
+        std::size_t playerIndex{ };
+        playerIndex < tournament.players.size();
+        ++playerIndex)
       {
-        metricScores.emplace_back(player, tournament, adjustedScores);
+        metricScores.emplace_back(
+          tournament.players[playerIndex],
+          tournament,
+          tiebreaks[playerIndex]);
       }
-      std::sort(
-        sortedPlayers.begin(),
-        sortedPlayers.end(),
+
+      // The rank indexes make the order total, so sorting in parallel gives
+      // the same result.
+      const auto metricCompare =
         [&metricScores,&tournament](
           const tournament::Player *const player0,
           const tournament::Player *const player1)
@@ -764,8 +696,19 @@ namespace swisssystems
             ) < std::make_tuple(
                   player0->scoreWithAcceleration(tournament),
                   metricScores[player0->id]);
-        }
-      );
+        };
+      if (threadPool && sortedPlayers.size() >= parallelSortThreshold)
+      {
+        utility::threadpool::sort(
+          *threadPool,
+          sortedPlayers.begin(),
+          sortedPlayers.end(),
+          metricCompare);
+      }
+      else
+      {
+        std::sort(sortedPlayers.begin(), sortedPlayers.end(), metricCompare);
+      }
 
       std::list<Pairing> result;
 
@@ -780,7 +723,10 @@ namespace swisssystems
         do
         {
           --playerIterator;
-          eligibleForBye = swisssystems::eligibleForByePre2025Rules(**playerIterator);
+          eligibleForBye =
+            swisssystems::eligibleForByePre2025Rules(
+              **playerIterator,
+              tournament);
         } while (playerIterator != sortedPlayers.begin() && !eligibleForBye);
         if (!eligibleForBye)
         {
@@ -1020,7 +966,10 @@ namespace swisssystems
         }
 
         // Starting with the highest player, find the lowest player that
-        // preserves the matching.
+        // preserves the matching. Once the scoregroup has been solved, the
+        // dual variables often prove which player that is, and the matching
+        // is only recomputed when they cannot.
+        bool matchingIsSolved{ };
         for (
           decltype(fullScoreGroup)::const_iterator vertexIterator
             = fullScoreGroup.begin();
@@ -1030,6 +979,8 @@ namespace swisssystems
           if (!matchingById[vertexLabels[*vertexIterator]->id])
           {
             matching_computer::edge_weight neighborPriority = 1;
+            std::vector<matching_computer::vertex_index> neighbors;
+            std::vector<matching_computer::edge_weight> edgeWeights;
             for (
               decltype(fullScoreGroup)::const_iterator neighborIterator =
                 std::next(vertexIterator, 1);
@@ -1047,14 +998,25 @@ namespace swisssystems
                     true);
                 if (edgeWeight)
                 {
-                  matchingComputer.setEdgeWeight(
-                    *vertexIterator,
-                    *neighborIterator,
-                    edgeWeight + neighborPriority++);
+                  neighbors.push_back(*neighborIterator);
+                  edgeWeights.push_back(edgeWeight + neighborPriority++);
                 }
               }
             }
-            matchingComputer.computeMatching();
+            if (
+              !matchingIsSolved
+                || !matchingComputer.setEdgeWeightsIfMatchIsForced(
+                      *vertexIterator,
+                      neighbors,
+                      edgeWeights))
+            {
+              matchingComputer.setEdgeWeights(
+                *vertexIterator,
+                neighbors,
+                edgeWeights);
+              matchingComputer.computeMatching();
+              matchingIsSolved = true;
+            }
             matching_computer::vertex_index match =
               matchingComputer.getMatching()[*vertexIterator];
             if (match >= *scoreGroupIterator)
@@ -1078,7 +1040,12 @@ namespace swisssystems
                   tournament,
                   metricScores));
 
-              finalizePair(*vertexIterator, match, matchingComputer);
+              matchingIsSolved =
+                matchingComputer.isolateMatchedPair(*vertexIterator, match, 1);
+              if (!matchingIsSolved)
+              {
+                finalizePair(*vertexIterator, match, matchingComputer);
+              }
             }
           }
         }
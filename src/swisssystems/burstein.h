@@ -60,17 +60,17 @@ namespace swisssystems
     }
 
     std::list<Pairing> computeMatching(
-      tournament::Tournament &&,
+      const tournament::Tournament &,
       std::ostream *const = nullptr);
 
     struct BursteinInfo final : public Info
     {
       std::list<Pairing> computeMatching(
-        tournament::Tournament &&tournament,
+        const tournament::Tournament &tournament,
         std::ostream *const ostream
       ) const override
       {
-        return burstein::computeMatching(std::move(tournament), ostream);
+        return burstein::computeMatching(tournament, ostream);
       }
       void updateAccelerations(tournament::Tournament &, tournament::round_index
       ) const override;
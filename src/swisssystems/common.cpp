@@ -24,23 +24,18 @@ namespace swisssystems
   namespace
   {
     /**
-     * Advance iterator to the next played game, stopping at endIterator if none
-     * is found.
+     * Move roundEnd back to just after the latest played game before it,
+     * stopping at zero if none is found.
      */
-    decltype(std::declval<tournament::Player>().matches)::const_reverse_iterator
-      skipUnplayedGames(
-        decltype(std::declval<tournament::Player>().matches)
-            ::const_reverse_iterator
-          iterator,
-        decltype(std::declval<tournament::Player>().matches)
-            ::const_reverse_iterator
-          endIterator)
+    tournament::round_index skipUnplayedGames(
+      const tournament::MatchHistory::PlayerMatches &matches,
+      tournament::round_index roundEnd)
     {
-      while (iterator != endIterator && !iterator->gameWasPlayed)
+      while (roundEnd && !matches[roundEnd - 1u].gameWasPlayed)
       {
-        ++iterator;
+        --roundEnd;
       }
-      return iterator;
+      return roundEnd;
     }
 
     /**
@@ -87,7 +82,7 @@ namespace swisssystems
       const tournament::Tournament &tournament)
     {
       std::string colorString;
-      for (const tournament::Match &match : player.matches)
+      for (const tournament::Match &match : tournament.matchHistory[player.id])
       {
         if (match.gameWasPlayed)
         {
@@ -116,10 +111,11 @@ namespace swisssystems
         roundIndex < tournament.playedRounds;
         ++roundIndex)
       {
+        const tournament::Match match =
+          tournament.matchHistory[player.id][roundIndex];
         result.push_back(
-          player.matches[roundIndex].gameWasPlayed
-            ? utility::uintstringconversion
-                ::toString(player.matches[roundIndex].opponent + 1u)
+          match.gameWasPlayed
+            ? utility::uintstringconversion::toString(match.opponent + 1u)
             : "");
       }
       return result;
@@ -216,29 +212,30 @@ namespace swisssystems
   void findFirstColorDifference(
     const tournament::Player &player0,
     const tournament::Player &player1,
+    const tournament::Tournament &tournament,
     tournament::Color &color0,
     tournament::Color &color1)
   {
-    auto iterator0 =
-      skipUnplayedGames(player0.matches.rbegin(), player0.matches.rend());
-    auto iterator1 =
-      skipUnplayedGames(player1.matches.rbegin(), player1.matches.rend());
+    const tournament::MatchHistory::PlayerMatches matches0 =
+      tournament.matchHistory[player0.id];
+    const tournament::MatchHistory::PlayerMatches matches1 =
+      tournament.matchHistory[player1.id];
+    tournament::round_index roundEnd0 =
+      skipUnplayedGames(matches0, matches0.size());
+    tournament::round_index roundEnd1 =
+      skipUnplayedGames(matches1, matches1.size());
     while (
-      iterator0 != player0.matches.rend()
-        && iterator1 != player1.matches.rend()
-        && iterator0->color == iterator1->color)
+      roundEnd0
+        && roundEnd1
+        && matches0[roundEnd0 - 1u].color == matches1[roundEnd1 - 1u].color)
     {
-      iterator0 = skipUnplayedGames(++iterator0, player0.matches.rend());
-      iterator1 = skipUnplayedGames(++iterator1, player1.matches.rend());
+      roundEnd0 = skipUnplayedGames(matches0, roundEnd0 - 1u);
+      roundEnd1 = skipUnplayedGames(matches1, roundEnd1 - 1u);
     }
     color0 =
-      iterator0 == player0.matches.rend()
-        ? tournament::COLOR_NONE
-        : iterator0->color;
+      roundEnd0 ? matches0[roundEnd0 - 1u].color : tournament::COLOR_NONE;
     color1 =
-      iterator1 == player1.matches.rend()
-        ? tournament::COLOR_NONE
-        : iterator1->color;
+      roundEnd1 ? matches1[roundEnd1 - 1u].color : tournament::COLOR_NONE;
   }
 
   /**
@@ -249,7 +246,8 @@ namespace swisssystems
    */
   tournament::Color choosePlayerNeutralColor(
     const tournament::Player &player,
-    const tournament::Player &opponent)
+    const tournament::Player &opponent,
+    const tournament::Tournament &tournament)
   {
     if (
       colorPreferencesAreCompatible(
@@ -300,6 +298,7 @@ namespace swisssystems
       findFirstColorDifference(
         player,
         opponent,
+        tournament,
         playerColor,
         opponentColor);
       if (
@@ -7,9 +7,18 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <tournament/tournament.h>
 
+/**
+ * The number of threads the pairing engines use for their per-player and
+ * per-pair computations (see the pairing_threads flag in the Makefile).
+ */
+#ifndef PAIRING_THREADS
+#define PAIRING_THREADS 1
+#endif
+
 namespace swisssystems
 {
   /**
@@ -60,8 +69,12 @@ namespace swisssystems
    */
   struct Info
   {
+    /**
+     * Compute the pairings for the next round. The Tournament is only read,
+     * so the checker and generator can pass their working copy directly.
+     */
     virtual std::list<Pairing> computeMatching(
-      tournament::Tournament &&,
+      const tournament::Tournament &,
       std::ostream *
     ) const = 0;
     /**
@@ -105,7 +118,7 @@ namespace swisssystems
     const tournament::Player &player,
     const tournament::Tournament &tournament)
   {
-    for (const tournament::Match &match : player.matches)
+    for (const tournament::Match &match : tournament.matchHistory[player.id])
     {
       if (
         !match.gameWasPlayed
@@ -123,9 +136,11 @@ namespace swisssystems
    * Check whether the player is eligible for the bye under the normal
    * restrictions imposed on all Swiss systems.
    */
-  inline bool eligibleForByePre2025Rules(const tournament::Player &player)
+  inline bool eligibleForByePre2025Rules(
+    const tournament::Player &player,
+    const tournament::Tournament &tournament)
   {
-    for (const tournament::Match &match : player.matches)
+    for (const tournament::Match &match : tournament.matchHistory[player.id])
     {
       if (
         !match.gameWasPlayed
@@ -141,11 +156,13 @@ namespace swisssystems
   void findFirstColorDifference(
     const tournament::Player &,
     const tournament::Player &,
+    const tournament::Tournament &,
     tournament::Color &,
     tournament::Color &);
   tournament::Color choosePlayerNeutralColor(
     const tournament::Player &,
-    const tournament::Player &);
+    const tournament::Player &,
+    const tournament::Tournament &);
 
   void sortResults(std::list<Pairing> &, const tournament::Tournament &);
 
@@ -167,32 +184,34 @@ namespace swisssystems
     MatchingComputer &matchingComputer,
     typename MatchingComputer::edge_weight defaultEdgeWeight = 1)
   {
+    std::vector<typename MatchingComputer::EdgeWeightUpdate> updates;
     for (
-      decltype(matchingComputer.size()) unpairedVertexIndex{ };
+      typename MatchingComputer::vertex_index unpairedVertexIndex{ };
       unpairedVertexIndex < matchingComputer.size();
       ++unpairedVertexIndex)
     {
       if (vertexIndex0 != unpairedVertexIndex)
       {
-        matchingComputer.setEdgeWeight(
+        updates.push_back({
           vertexIndex0,
           unpairedVertexIndex,
           unpairedVertexIndex == vertexIndex1
             ? defaultEdgeWeight
             : defaultEdgeWeight & 0u
-        );
+        });
       }
       if (vertexIndex1 != unpairedVertexIndex)
       {
-        matchingComputer.setEdgeWeight(
+        updates.push_back({
           vertexIndex1,
           unpairedVertexIndex,
           unpairedVertexIndex == vertexIndex0
             ? defaultEdgeWeight
             : defaultEdgeWeight & 0u
-        );
+        });
       }
     }
+    matchingComputer.setEdgeWeights(updates);
   }
 }
 
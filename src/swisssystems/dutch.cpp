@@ -1,9 +1,12 @@
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <iterator>
+#include <limits>
 #include <list>
+#include <memory>
 #include <ostream>
 #include <stdexcept>
 #include <string>
@@ -13,7 +16,11 @@
 #include <vector>
 
 #include <tournament/tournament.h>
+#include <utility/bitmatrix.h>
+#include <utility/dynamicuint.h>
+#include <utility/threadpool.h>
 #include <utility/typesizes.h>
+#include <utility/uint.h>
 #include <utility/uintstringconversion.h>
 #include <utility/uinttypes.h>
 
@@ -35,8 +42,7 @@ namespace swisssystems
         const tournament::Player &player0,
         const tournament::Player &player1,
         const tournament::Tournament &tournament,
-        const std::vector<std::unordered_set<tournament::player_index>>
-          &forbiddenPairs)
+        const utility::bitmatrix::BitMatrix &forbiddenPairs)
       {
         constexpr unsigned int maxPointsSize =
           utility::typesizes
@@ -55,7 +61,7 @@ namespace swisssystems
             * std::max(tournament.pointsForWin, tournament.pointsForDraw)
             >> 1;
         return
-          !forbiddenPairs[player0.id].count(player1.id)
+          !forbiddenPairs.test(player0.id, player1.id)
             && (!player0.absoluteColorPreference()
                   || !player1.absoluteColorPreference()
                   || player0.colorPreference != player1.colorPreference
@@ -112,8 +118,10 @@ namespace swisssystems
         const tournament::round_index roundsBack,
         const tournament::Tournament &tournament)
       {
-        const tournament::Match &match =
-          player.matches[tournament.playedRounds - roundsBack];
+        const tournament::Match match =
+          tournament.matchHistory
+            [player.id]
+            [tournament.playedRounds - roundsBack];
         if (!match.gameWasPlayed)
         {
           return
@@ -132,17 +140,287 @@ namespace swisssystems
             : FLOAT_NONE;
       }
 
+      typedef tournament::player_index score_group_shift;
+
+      /**
+       * The criteria computeEdgeWeight evaluates for single players and for
+       * pairs of players, computed once per round after the players are
+       * sorted, so that weighting each pairing bracket only reads them. The
+       * criteria of a pair are packed into one byte, stored in a triangular
+       * table indexed by the players' positions in sortedPlayers.
+       */
+      class PairingCriteria
+      {
+      public:
+        typedef unsigned char pair_criteria;
+
+        /**
+         * The bits of a pair_criteria. The color criteria are listed in the
+         * order in which insertColorBits places them in the edge weight.
+         */
+        enum PairCriterion : pair_criteria
+        {
+          PAIR_COMPATIBLE = 1u,
+          PAIR_NO_ABSOLUTE_COLOR_IMBALANCE_CONFLICT = 2u,
+          PAIR_NO_ABSOLUTE_COLOR_PREFERENCE_CONFLICT = 4u,
+          PAIR_COMPATIBLE_COLOR_PREFERENCES = 8u,
+          PAIR_NO_STRONG_COLOR_PREFERENCE_CONFLICT = 16u
+        };
+
+        PairingCriteria(
+          const std::vector<const tournament::Player *> &sortedPlayers,
+          const tournament::Tournament &tournament,
+          const utility::bitmatrix::BitMatrix &forbiddenPairs)
+          : positions(tournament.players.size())
+        {
+          const std::size_t playerCount = sortedPlayers.size();
+          pairs.reserve(
+            playerCount ? playerCount * (playerCount - 1u) / 2u : 0u);
+          floats.reserve(playerCount * 2u);
+          tournament::player_index position{ };
+          for (const tournament::Player *const player : sortedPlayers)
+          {
+            positions[player->id] = position++;
+            scores.push_back(player->scoreWithAcceleration(tournament));
+            floats.push_back(
+              tournament.playedRounds
+                ? dutch::getFloat(*player, 1u, tournament)
+                : FLOAT_NONE);
+            floats.push_back(
+              tournament.playedRounds > 1u
+                ? dutch::getFloat(*player, 2u, tournament)
+                : FLOAT_NONE);
+            byeEligibilities.push_back(eligibleForBye(*player, tournament));
+
+            for (const tournament::Player *const opponent : sortedPlayers)
+            {
+              if (opponent == player)
+              {
+                break;
+              }
+              pairs.push_back(
+                computePairCriteria(
+                  *player,
+                  *opponent,
+                  tournament,
+                  forbiddenPairs));
+            }
+          }
+
+          // Lay out the fields minimizing the scores of repeated downfloaters,
+          // giving each score group only the bits needed to count its players
+          // who floated down, so that most score groups take no room.
+          downfloaterGroupOffsets.resize(playerCount * 2u);
+          for (std::size_t roundsBack = 1u; roundsBack <= 2u; ++roundsBack)
+          {
+            score_group_shift &fieldWidth =
+              downfloaterFieldWidths[roundsBack - 1u];
+            tournament::player_index downfloaters{ };
+            std::size_t scoreGroupEnd = playerCount;
+            for (std::size_t index = playerCount; index--; )
+            {
+              downfloaters +=
+                floats[index * 2u + roundsBack - 1u] == FLOAT_DOWN;
+              if (!index || scores[index - 1u] > scores[index])
+              {
+                for (
+                  std::size_t member = index;
+                  member < scoreGroupEnd;
+                  ++member)
+                {
+                  downfloaterGroupOffsets[member * 2u + roundsBack - 1u] =
+                    fieldWidth;
+                }
+                fieldWidth +=
+                  utility::typesizes::bitsToRepresent<unsigned int>(
+                    downfloaters);
+                downfloaters = 0u;
+                scoreGroupEnd = index;
+              }
+            }
+          }
+        }
+
+        /**
+         * Return the criteria of the pair of distinct players.
+         */
+        pair_criteria getPairCriteria(
+          const tournament::Player &player0,
+          const tournament::Player &player1
+        ) const
+        {
+          std::size_t position0 = positions[player0.id];
+          std::size_t position1 = positions[player1.id];
+          assert(position0 != position1);
+          if (position0 < position1)
+          {
+            std::swap(position0, position1);
+          }
+          return pairs[position0 * (position0 - 1u) / 2u + position1];
+        }
+
+        tournament::points getScore(const tournament::Player &player) const
+        {
+          return scores[positions[player.id]];
+        }
+
+        /**
+         * The float direction of the player in the round roundsBack before
+         * the current round, which must be 1 or 2.
+         */
+        Float getFloat(
+          const tournament::Player &player,
+          const tournament::round_index roundsBack
+        ) const
+        {
+          assert(roundsBack == 1u || roundsBack == 2u);
+          return floats[positions[player.id] * 2u + roundsBack - 1u];
+        }
+
+        /**
+         * The width of the field minimizing the scores of the players who
+         * floated down roundsBack rounds before the current round.
+         */
+        score_group_shift getDownfloaterFieldWidth(
+          const tournament::round_index roundsBack
+        ) const
+        {
+          assert(roundsBack == 1u || roundsBack == 2u);
+          return downfloaterFieldWidths[roundsBack - 1u];
+        }
+
+        /**
+         * The offset of the player's score group in the field minimizing the
+         * scores of the players who floated down roundsBack rounds before the
+         * current round.
+         */
+        score_group_shift getDownfloaterGroupOffset(
+          const tournament::Player &player,
+          const tournament::round_index roundsBack
+        ) const
+        {
+          assert(roundsBack == 1u || roundsBack == 2u);
+          return
+            downfloaterGroupOffsets[
+              positions[player.id] * 2u + roundsBack - 1u];
+        }
+
+        /**
+         * Return whether a player receives the pairing-allocated bye.
+         */
+        bool hasBye() const
+        {
+          return scores.size() & 1u;
+        }
+
+        bool isEligibleForBye(const tournament::Player &player) const
+        {
+          return byeEligibilities[positions[player.id]];
+        }
+
+        bool isByeCandidate(
+          const tournament::Player &player,
+          const tournament::points byeAssigneeScore
+        ) const
+        {
+          return
+            isEligibleForBye(player) && getScore(player) <= byeAssigneeScore;
+        }
+
+      private:
+        /**
+         * The position of each player in sortedPlayers, indexed by ID.
+         */
+        std::vector<tournament::player_index> positions;
+        /**
+         * The criteria of the players at positions i > j, at index
+         * i * (i - 1) / 2 + j.
+         */
+        std::vector<pair_criteria> pairs;
+        std::vector<tournament::points> scores;
+        /**
+         * The float directions one and two rounds back, two per position.
+         */
+        std::vector<Float> floats;
+        std::vector<bool> byeEligibilities;
+        /**
+         * The values of getDownfloaterFieldWidth one and two rounds back.
+         */
+        score_group_shift downfloaterFieldWidths[2]{ };
+        /**
+         * The values of getDownfloaterGroupOffset one and two rounds back, two
+         * per position.
+         */
+        std::vector<score_group_shift> downfloaterGroupOffsets;
+
+        /**
+         * Evaluate the pair criteria for player and an opponent preceding
+         * them in sortedPlayers.
+         */
+        static pair_criteria computePairCriteria(
+          const tournament::Player &player,
+          const tournament::Player &opponent,
+          const tournament::Tournament &tournament,
+          const utility::bitmatrix::BitMatrix &forbiddenPairs)
+        {
+          pair_criteria result{ };
+          if (compatible(opponent, player, tournament, forbiddenPairs))
+          {
+            result |= PAIR_COMPATIBLE;
+          }
+          if (
+            !player.absoluteColorImbalance()
+              || !opponent.absoluteColorImbalance()
+              || player.colorPreference != opponent.colorPreference)
+          {
+            result |= PAIR_NO_ABSOLUTE_COLOR_IMBALANCE_CONFLICT;
+          }
+          if (
+            !player.absoluteColorPreference()
+              || !opponent.absoluteColorPreference()
+              || player.colorPreference != opponent.colorPreference
+              || (player.colorImbalance == opponent.colorImbalance
+                    ? player.repeatedColor == tournament::COLOR_NONE
+                        || player.repeatedColor != opponent.repeatedColor
+                    : (player.colorImbalance > opponent.colorImbalance
+                        ? opponent
+                        : player
+                      ).repeatedColor
+                          != tournament::invert(player.colorPreference)))
+          {
+            result |= PAIR_NO_ABSOLUTE_COLOR_PREFERENCE_CONFLICT;
+          }
+          if (
+            colorPreferencesAreCompatible(
+              player.colorPreference,
+              opponent.colorPreference))
+          {
+            result |= PAIR_COMPATIBLE_COLOR_PREFERENCES;
+          }
+          if (
+            (!player.strongColorPreference
+                && !player.absoluteColorPreference()
+              ) || (!opponent.strongColorPreference
+                      && !opponent.absoluteColorPreference())
+                || (player.absoluteColorPreference()
+                      && opponent.absoluteColorPreference())
+                || player.colorPreference != opponent.colorPreference)
+          {
+            result |= PAIR_NO_STRONG_COLOR_PREFERENCE_CONFLICT;
+          }
+          return result;
+        }
+      };
+
       /**
        * Left-shift the edgeWeight by the specified amount. If max is true,
        * also expand the number of pieces in edgeWeight so the shifted value
        * will fit.
        */
-      template <bool max, typename Shift>
-      void shiftEdgeWeight(
-        matching_computer::edge_weight &edgeWeight,
-        const Shift shift)
+      template <bool max, typename edge_weight, typename Shift>
+      void shiftEdgeWeight(edge_weight &edgeWeight, const Shift shift)
       {
-        if (max)
+        if constexpr (max)
         {
           edgeWeight.shiftGrow(shift);
         }
@@ -155,80 +433,39 @@ namespace swisssystems
       /**
        * Given edgeWeight containing the high-order bits of the edge weight,
        * shift it over to make room for the bits reserved for color preferences,
-       * and set the appropriate bits to true.
+       * and set the bits of the color criteria in pairCriteria to true.
        * If max is true, just shift without setting bits to true.
        */
-      template <bool max>
+      template <bool max, typename edge_weight>
       void insertColorBits(
-        matching_computer::edge_weight &edgeWeight,
-        const tournament::Player &player,
-        const tournament::Player &opponent,
+        edge_weight &edgeWeight,
+        const PairingCriteria::pair_criteria pairCriteria,
         const bool inCurrentScoreGroup,
         const tournament::player_index playerCountBits)
       {
         const bool mask = !max && inCurrentScoreGroup;
 
-        shiftEdgeWeight<max>(edgeWeight, playerCountBits);
-        edgeWeight |=
-          mask
-            && (!player.absoluteColorImbalance()
-                  || !opponent.absoluteColorImbalance()
-                  || player.colorPreference != opponent.colorPreference);
-
-        shiftEdgeWeight<max>(edgeWeight, playerCountBits);
-        edgeWeight |=
-          mask
-            && (!player.absoluteColorPreference()
-                  || !opponent.absoluteColorPreference()
-                  || player.colorPreference != opponent.colorPreference
-                  || (player.colorImbalance == opponent.colorImbalance
-                        ? player.repeatedColor == tournament::COLOR_NONE
-                            || player.repeatedColor != opponent.repeatedColor
-                        : (player.colorImbalance > opponent.colorImbalance
-                            ? opponent
-                            : player
-                          ).repeatedColor
-                              != tournament::invert(player.colorPreference)));
-
-        shiftEdgeWeight<max>(edgeWeight, playerCountBits);
-        edgeWeight |=
-          mask
-            && colorPreferencesAreCompatible(
-                player.colorPreference,
-                opponent.colorPreference);
-
-        shiftEdgeWeight<max>(edgeWeight, playerCountBits);
-        edgeWeight |=
-          mask
-            && ((!player.strongColorPreference
-                    && !player.absoluteColorPreference()
-                  ) || (!opponent.strongColorPreference
-                          && !opponent.absoluteColorPreference())
-                    || (player.absoluteColorPreference()
-                          && opponent.absoluteColorPreference())
-                    || player.colorPreference != opponent.colorPreference
-                );
-      }
-
-      bool isByeCandidate(
-        const tournament::Player &player,
-        const tournament::Tournament &tournament,
-        const tournament::points byeAssigneeScore)
-      {
-        return
-          eligibleForBye(player, tournament)
-            && player.scoreWithAcceleration(tournament) <= byeAssigneeScore;
+        for (
+          const PairingCriteria::PairCriterion criterion
+            : {
+                PairingCriteria::PAIR_NO_ABSOLUTE_COLOR_IMBALANCE_CONFLICT,
+                PairingCriteria::PAIR_NO_ABSOLUTE_COLOR_PREFERENCE_CONFLICT,
+                PairingCriteria::PAIR_COMPATIBLE_COLOR_PREFERENCES,
+                PairingCriteria::PAIR_NO_STRONG_COLOR_PREFERENCE_CONFLICT
+              })
+        {
+          shiftEdgeWeight<max>(edgeWeight, playerCountBits);
+          edgeWeight |= mask && (pairCriteria & criterion);
+        }
       }
 
-      typedef tournament::player_index score_group_shift;
-
       /**
        * Compute the basic edge weight between the two players. If max is true,
        * compute an upper bound on the edge weight for this pairing bracket
        * instead.
        */
-      template <bool max = false>
-      matching_computer::edge_weight
+      template <bool max = false, typename edge_weight>
+      edge_weight
         computeEdgeWeight(
           const tournament::Player &higherPlayer,
           const tournament::Player &lowerPlayer,
@@ -236,8 +473,7 @@ namespace swisssystems
           const bool lowerPlayerInNextBracket,
           const tournament::points byeAssigneeScore,
           const tournament::Tournament &tournament,
-          const std::vector<std::unordered_set<tournament::player_index>>
-            &forbiddenPairs,
+          const PairingCriteria &criteria,
           const unsigned int scoreGroupSizeBits,
           const score_group_shift scoreGroupsShift,
           const std::unordered_map<tournament::points, score_group_shift>
@@ -248,26 +484,19 @@ namespace swisssystems
               tournament::round_index,
               tournament::player_index>
             &unplayedGameRanks,
-          matching_computer::edge_weight &maxEdgeWeight)
+          edge_weight &maxEdgeWeight)
       {
         typename
-            std::conditional<
-              max,
-              decltype(maxEdgeWeight),
-              matching_computer::edge_weight
-            >::type
+            std::conditional<max, decltype(maxEdgeWeight), edge_weight>::type
           result{ maxEdgeWeight };
 
         result &= 0u;
 
+        const PairingCriteria::pair_criteria pairCriteria =
+          max ? 0u : criteria.getPairCriteria(higherPlayer, lowerPlayer);
+
         // Check compatibility.
-        if (
-          !max
-            && !compatible(
-                  higherPlayer,
-                  lowerPlayer,
-                  tournament,
-                  forbiddenPairs))
+        if (!max && !(pairCriteria & PairingCriteria::PAIR_COMPATIBLE))
         {
           return result;
         }
@@ -277,8 +506,8 @@ namespace swisssystems
           max
             ? 2u
             : 1u
-                + !isByeCandidate(higherPlayer, tournament, byeAssigneeScore)
-                + !isByeCandidate(lowerPlayer, tournament, byeAssigneeScore);
+                + !criteria.isByeCandidate(higherPlayer, byeAssigneeScore)
+                + !criteria.isByeCandidate(lowerPlayer, byeAssigneeScore);
 
         // Maximize the number of pairs in the current pairing bracket.
         assert(scoreGroupSizeBits);
@@ -292,7 +521,7 @@ namespace swisssystems
           result |=
             ((result & 0u) | 1u)
               << scoreGroupShifts.find(
-                    higherPlayer.scoreWithAcceleration(tournament)
+                    criteria.getScore(higherPlayer)
                   )->second;
         }
 
@@ -307,21 +536,24 @@ namespace swisssystems
           result |=
             ((result & 0u) | 1u)
               << scoreGroupShifts.find(
-                    higherPlayer.scoreWithAcceleration(tournament)
+                    criteria.getScore(higherPlayer)
                   )->second;
         }
 
         // Minimize number of unplayed games of bye assignee
-        shiftEdgeWeight<max>(result, scoreGroupSizeBits);
-        shiftEdgeWeight<max>(result, scoreGroupSizeBits);
+        if (criteria.hasBye())
+        {
+          shiftEdgeWeight<max>(result, scoreGroupSizeBits);
+          shiftEdgeWeight<max>(result, scoreGroupSizeBits);
+        }
         if (!max && isSingleDownloaterTheByeAssignee)
         {
           if (
-            higherPlayer.scoreWithAcceleration(tournament) == byeAssigneeScore)
+            criteria.getScore(higherPlayer) == byeAssigneeScore)
           {
             result |= unplayedGameRanks.find(higherPlayer.playedGames)->second;
           }
-          if (lowerPlayer.scoreWithAcceleration(tournament) == byeAssigneeScore)
+          if (criteria.getScore(lowerPlayer) == byeAssigneeScore)
           {
             result += unplayedGameRanks.find(lowerPlayer.playedGames)->second;
           }
@@ -330,8 +562,7 @@ namespace swisssystems
         // Maximize color preference satisfaction.
         insertColorBits<max>(
           result,
-          lowerPlayer,
-          higherPlayer,
+          pairCriteria,
           lowerPlayerInCurrentBracket,
           scoreGroupSizeBits);
 
@@ -341,11 +572,11 @@ namespace swisssystems
           shiftEdgeWeight<max>(result, scoreGroupSizeBits);
           if (!max && lowerPlayerInCurrentBracket)
           {
-            result |= getFloat(lowerPlayer, 1, tournament) == FLOAT_DOWN;
+            result |= criteria.getFloat(lowerPlayer, 1) == FLOAT_DOWN;
             result +=
-              higherPlayer.scoreWithAcceleration(tournament)
-                  <= lowerPlayer.scoreWithAcceleration(tournament)
-                && getFloat(higherPlayer, 1, tournament) == FLOAT_DOWN;
+              criteria.getScore(higherPlayer)
+                  <= criteria.getScore(lowerPlayer)
+                && criteria.getFloat(higherPlayer, 1) == FLOAT_DOWN;
           }
 
           // Minimize upfloaters repeated from the previous round.
@@ -353,9 +584,9 @@ namespace swisssystems
           if (!max && lowerPlayerInCurrentBracket)
           {
             result |=
-              !(higherPlayer.scoreWithAcceleration(tournament)
-                    > lowerPlayer.scoreWithAcceleration(tournament)
-                  && getFloat(lowerPlayer, 1, tournament) == FLOAT_UP);
+              !(criteria.getScore(higherPlayer)
+                    > criteria.getScore(lowerPlayer)
+                  && criteria.getFloat(lowerPlayer, 1) == FLOAT_UP);
           }
         }
         if (tournament.playedRounds > 1u)
@@ -364,11 +595,11 @@ namespace swisssystems
           shiftEdgeWeight<max>(result, scoreGroupSizeBits);
           if (!max && lowerPlayerInCurrentBracket)
           {
-            result |= getFloat(lowerPlayer, 2, tournament) == FLOAT_DOWN;
+            result |= criteria.getFloat(lowerPlayer, 2) == FLOAT_DOWN;
             result +=
-              higherPlayer.scoreWithAcceleration(tournament)
-                  <= lowerPlayer.scoreWithAcceleration(tournament)
-                && getFloat(higherPlayer, 2, tournament) == FLOAT_DOWN;
+              criteria.getScore(higherPlayer)
+                  <= criteria.getScore(lowerPlayer)
+                && criteria.getFloat(higherPlayer, 2) == FLOAT_DOWN;
           }
 
           // Minimize upfloaters repeated from two rounds before.
@@ -376,9 +607,9 @@ namespace swisssystems
           if (!max && lowerPlayerInCurrentBracket)
           {
             result |=
-              !(higherPlayer.scoreWithAcceleration(tournament)
-                    > lowerPlayer.scoreWithAcceleration(tournament)
-                  && getFloat(lowerPlayer, 2, tournament) == FLOAT_UP);
+              !(criteria.getScore(higherPlayer)
+                    > criteria.getScore(lowerPlayer)
+                  && criteria.getFloat(lowerPlayer, 2) == FLOAT_UP);
           }
         }
 
@@ -386,21 +617,19 @@ namespace swisssystems
         {
           // Minimize the scores of downfloaters repeated from the previous
           // round.
-          shiftEdgeWeight<max>(result, scoreGroupsShift);
+          shiftEdgeWeight<max>(
+            result,
+            criteria.getDownfloaterFieldWidth(1));
           if (!max && lowerPlayerInCurrentBracket)
           {
             result +=
               ((result & 0u)
-                | (getFloat(lowerPlayer, 1, tournament) == FLOAT_DOWN)
-              ) << scoreGroupShifts.find(
-                      lowerPlayer.scoreWithAcceleration(tournament)
-                    )->second;
+                | (criteria.getFloat(lowerPlayer, 1) == FLOAT_DOWN)
+              ) << criteria.getDownfloaterGroupOffset(lowerPlayer, 1);
             result +=
               ((result & 0u)
-                | (getFloat(higherPlayer, 1, tournament) == FLOAT_DOWN)
-              ) << scoreGroupShifts.find(
-                      higherPlayer.scoreWithAcceleration(tournament)
-                    )->second;
+                | (criteria.getFloat(higherPlayer, 1) == FLOAT_DOWN)
+              ) << criteria.getDownfloaterGroupOffset(higherPlayer, 1);
           }
 
           // Minimize the scores of the opponents of upfloaters repeated from
@@ -409,14 +638,14 @@ namespace swisssystems
           if (
             !max
               && lowerPlayerInCurrentBracket
-              && !(getFloat(lowerPlayer, 1, tournament) == FLOAT_UP
-                    && higherPlayer.scoreWithAcceleration(tournament)
-                        > lowerPlayer.scoreWithAcceleration(tournament)))
+              && !(criteria.getFloat(lowerPlayer, 1) == FLOAT_UP
+                    && criteria.getScore(higherPlayer)
+                        > criteria.getScore(lowerPlayer)))
           {
             result |=
               ((result & 0u) | 1u)
                 << scoreGroupShifts.find(
-                      higherPlayer.scoreWithAcceleration(tournament)
+                      criteria.getScore(higherPlayer)
                     )->second;
           }
         }
@@ -424,21 +653,19 @@ namespace swisssystems
         {
           // Minimize the scores of downfloaters repeated from two rounds
           // before.
-          shiftEdgeWeight<max>(result, scoreGroupsShift);
+          shiftEdgeWeight<max>(
+            result,
+            criteria.getDownfloaterFieldWidth(2));
           if (!max && lowerPlayerInCurrentBracket)
           {
             result +=
               ((result & 0u)
-                | (getFloat(lowerPlayer, 2, tournament) == FLOAT_DOWN)
-              ) << scoreGroupShifts.find(
-                      lowerPlayer.scoreWithAcceleration(tournament)
-                    )->second;
+                | (criteria.getFloat(lowerPlayer, 2) == FLOAT_DOWN)
+              ) << criteria.getDownfloaterGroupOffset(lowerPlayer, 2);
             result +=
               ((result & 0u)
-                | (getFloat(higherPlayer, 2, tournament) == FLOAT_DOWN)
-              ) << scoreGroupShifts.find(
-                      higherPlayer.scoreWithAcceleration(tournament)
-                    )->second;
+                | (criteria.getFloat(higherPlayer, 2) == FLOAT_DOWN)
+              ) << criteria.getDownfloaterGroupOffset(higherPlayer, 2);
           }
 
           // Minimize the scores of opponents of upfloaters repeated from two
@@ -447,14 +674,14 @@ namespace swisssystems
           if (
             !max
               && lowerPlayerInCurrentBracket
-              && !(getFloat(lowerPlayer, 2, tournament) == FLOAT_UP
-                    && higherPlayer.scoreWithAcceleration(tournament)
-                        > lowerPlayer.scoreWithAcceleration(tournament)))
+              && !(criteria.getFloat(lowerPlayer, 2) == FLOAT_UP
+                    && criteria.getScore(higherPlayer)
+                        > criteria.getScore(lowerPlayer)))
           {
             result |=
               ((result & 0u) | 1u)
                 << scoreGroupShifts.find(
-                      higherPlayer.scoreWithAcceleration(tournament)
+                      criteria.getScore(higherPlayer)
                     )->second;
           }
         }
@@ -468,7 +695,7 @@ namespace swisssystems
 
         shiftEdgeWeight<max>(result, 1u);
 
-        if (max)
+        if constexpr (max)
         {
           // The edge weight should have room to expand by two bits for the
           // matching subroutine.
@@ -491,7 +718,7 @@ namespace swisssystems
         const tournament::Tournament &tournament)
       {
         const tournament::Color result =
-          choosePlayerNeutralColor(player, opponent);
+          choosePlayerNeutralColor(player, opponent, tournament);
         return
           result == tournament::COLOR_NONE
             ? player.colorPreference == tournament::COLOR_NONE
@@ -581,17 +808,21 @@ namespace swisssystems
        * pairing bracket and the next. The resulting vector is indexed by the
        * larger player index, and the sub-vectors are indexed by the smaller
        * player index.
+       *
+       * If threadPool is not null, the rows are computed in parallel. Each
+       * row is written by a single task, so the result is the same.
        */
-      std::vector<std::vector<matching_computer::edge_weight>>
+      template <typename edge_weight>
+      std::vector<std::vector<edge_weight>>
       computeBaseEdgeWeights(
-        matching_computer::edge_weight &maxEdgeWeight,
+        utility::threadpool::ThreadPool *const threadPool,
+        edge_weight &maxEdgeWeight,
         const std::vector<const tournament::Player *> &playersByIndex,
         const tournament::player_index scoreGroupBegin,
         const tournament::player_index nextScoreGroupBegin,
         const tournament::points byeAssigneeScore,
         const tournament::Tournament &tournament,
-        const std::vector<std::unordered_set<tournament::player_index>>
-          &forbiddenPairs,
+        const PairingCriteria &criteria,
         const unsigned int scoreGroupSizeBits,
         const score_group_shift scoreGroupsShift,
         const std::unordered_map<tournament::points, score_group_shift>
@@ -601,200 +832,279 @@ namespace swisssystems
           std::unordered_map<tournament::round_index, tournament::player_index>
           &unplayedGameRanks)
       {
-        std::vector<std::vector<matching_computer::edge_weight>>
-          result(playersByIndex.size());
+        std::vector<std::vector<edge_weight>> result(playersByIndex.size());
 
-        for (
-          tournament::player_index largerPlayerIndex = scoreGroupBegin;
-          largerPlayerIndex < playersByIndex.size();
-          ++largerPlayerIndex)
+        const auto computeRow =
+          [&](const tournament::player_index largerPlayerIndex)
+          {
+            std::vector<edge_weight> &row = result[largerPlayerIndex];
+            row.reserve(largerPlayerIndex);
+            for (
+              tournament::player_index smallerPlayerIndex = 0;
+              smallerPlayerIndex < largerPlayerIndex;
+              ++smallerPlayerIndex)
+            {
+              row.emplace_back(
+                computeEdgeWeight(
+                  *playersByIndex[smallerPlayerIndex],
+                  *playersByIndex[largerPlayerIndex],
+                  largerPlayerIndex < nextScoreGroupBegin,
+                  largerPlayerIndex >= nextScoreGroupBegin,
+                  byeAssigneeScore,
+                  tournament,
+                  criteria,
+                  scoreGroupSizeBits,
+                  scoreGroupsShift,
+                  scoreGroupShifts,
+                  isSingleDownfloaterTheByeAssignee,
+                  unplayedGameRanks,
+                  maxEdgeWeight));
+            }
+          };
+
+        if (threadPool)
+        {
+          threadPool->run(
+            playersByIndex.size() - scoreGroupBegin,
+            [&computeRow, scoreGroupBegin](const std::size_t task, std::size_t)
+            {
+              computeRow(scoreGroupBegin + task);
+            });
+        }
+        else
         {
           for (
-            tournament::player_index smallerPlayerIndex = 0;
-            smallerPlayerIndex < largerPlayerIndex;
-            ++smallerPlayerIndex)
+            tournament::player_index largerPlayerIndex = scoreGroupBegin;
+            largerPlayerIndex < playersByIndex.size();
+            ++largerPlayerIndex)
           {
-            result[largerPlayerIndex].emplace_back(
-              computeEdgeWeight(
-                *playersByIndex[smallerPlayerIndex],
-                *playersByIndex[largerPlayerIndex],
-                largerPlayerIndex < nextScoreGroupBegin,
-                largerPlayerIndex >= nextScoreGroupBegin,
-                byeAssigneeScore,
-                tournament,
-                forbiddenPairs,
-                scoreGroupSizeBits,
-                scoreGroupsShift,
-                scoreGroupShifts,
-                isSingleDownfloaterTheByeAssignee,
-                unplayedGameRanks,
-                maxEdgeWeight));
+            computeRow(largerPlayerIndex);
           }
         }
 
         return result;
       }
-    }
 
-    /**
-     * Compute the matching, and return the list of Pairings in arbitrary order.
-     * If no matching is possible, throw a NoValidPairingException.
-     * This runs in theoretic time O(n^3 * s^2 * log n), where n is the
-     * number of players and s is the number of occupied score groups.
-     */
-    std::list<Pairing> computeMatching(
-      tournament::Tournament &&tournament,
-      std::ostream *const ostream)
-    {
-      // Filter out the absent players, and sort the remainder by score and
-      // pairing ID.
-      std::vector<const tournament::Player *> sortedPlayers;
-      // We add forbidden pairs due to previous matches below
-      auto forbiddenPairs = tournament.resolveForbiddenPairs(tournament.playedRounds);
-      for (tournament::Player &player : tournament.players)
+      /**
+       * Convert value to a fixed-width integer with the specified number of
+       * pieces, which must be enough to represent it.
+       */
+      template <std::size_t pieces>
+      utility::uinttypes::uint<pieces> toFixedWidth(
+        const utility::uinttypes::DynamicUint &value)
       {
-        if (player.isValid)
+        const utility::uinttypes::DynamicUint::const_view valueView{ value };
+        utility::uinttypes::uint<pieces> result{ 0u };
+        for (auto iterator = valueView.end(); iterator != valueView.begin(); )
         {
-          if (player.matches.size() <= tournament.playedRounds)
-          {
-            sortedPlayers.push_back(&player);
-          }
-          for (const tournament::Match &match : player.matches)
+          --iterator;
+          result <<= std::numeric_limits<std::uintmax_t>::digits;
+          result |= *iterator;
+        }
+        return result;
+      }
+
+      /**
+       * Return whether the computations of matchingComputer should only visit
+       * the edges of nonzero weight when scanning for the minimum outer-outer
+       * edges. The neighbor lists this needs only pay off once at most a
+       * quarter of the edges have nonzero weight, as in late rounds or with
+       * many forbidden pairs.
+       */
+      template <typename edge_weight>
+      bool shouldFilterOuterOuterScans(
+        const matching::Computer<edge_weight> &matchingComputer)
+      {
+        const std::size_t size = matchingComputer.size();
+        return
+          matchingComputer.getNonzeroEdgeCount() * 8u
+            <= size * (size - 1u);
+      }
+
+#ifdef DUTCH_BRACKET_LOCAL
+      /**
+       * Replace matchingComputer with a smaller one holding only the vertices
+       * that are not in finalized pairs, keeping their order and edge weights.
+       * These are the vertices in vertexIndices that are less than
+       * scoreGroupBeginVertex, and all the vertices from scoreGroupBeginVertex
+       * on. The vertices in playersByVertex, vertexIndices, and
+       * scoreGroupBeginVertex are renumbered to match, matched is reindexed,
+       * and the statistics of the old matching computer are added to
+       * retiredStats.
+       *
+       * The finalized pairs have no edges to the other vertices, so the
+       * remaining problem, including the completability of the later brackets,
+       * is unchanged.
+       */
+      template <typename edge_weight>
+      void compactMatchingComputer(
+        matching::Computer<edge_weight> &matchingComputer,
+        const edge_weight &maxEdgeWeight,
+        std::vector<const tournament::Player *> &playersByVertex,
+        std::vector<bool> &matched,
+        std::vector<tournament::player_index> &vertexIndices,
+        tournament::player_index &scoreGroupBeginVertex,
+        matching::Stats &retiredStats)
+      {
+        std::vector<tournament::player_index> keptVertices;
+        for (const tournament::player_index vertex : vertexIndices)
+        {
+          if (vertex < scoreGroupBeginVertex)
           {
-            if (match.gameWasPlayed)
-            {
-              forbiddenPairs[player.id].insert(match.opponent);
-            }
+            keptVertices.push_back(vertex);
           }
         }
-      }
-      std::sort(
-        sortedPlayers.begin(),
-        sortedPlayers.end(),
-        [&tournament](
-          const tournament::Player *const player0,
-          const tournament::Player *const player1)
+        const tournament::player_index movedDownPlayers = keptVertices.size();
+        for (
+          tournament::player_index vertex = scoreGroupBeginVertex;
+          vertex < matchingComputer.size();
+          ++vertex)
         {
-          return
-            tournament
-              ::acceleratedScoreRankCompare(player1, player0, tournament);
+          keptVertices.push_back(vertex);
         }
-      );
 
-      // Calculate the number of bits needed to prioritize moved-down players.
-      score_group_shift scoreGroupsShift{ };
-      std::unordered_map<tournament::points, score_group_shift>
-        scoreGroupShifts{ };
-      tournament::player_index maxScoreGroupSize{ };
-      tournament::player_index repeatedScores{ };
-      for (
-        auto nextIterator = sortedPlayers.rbegin();
-        nextIterator != sortedPlayers.rend();
-      )
-      {
-        const auto currentIterator = nextIterator++;
-        ++repeatedScores;
-        const tournament::points currentScore =
-          (*currentIterator)->scoreWithAcceleration(tournament);
-        if (
-          nextIterator == sortedPlayers.rend()
-            || currentScore < (*nextIterator)->scoreWithAcceleration(tournament)
-        )
+        matching::Computer<edge_weight> result(
+          keptVertices.size(),
+          maxEdgeWeight);
+        std::vector<const tournament::Player *> newPlayersByVertex;
+        std::vector<bool> newMatched;
+        std::vector<tournament::player_index> neighbors;
+        std::vector<edge_weight> edgeWeights;
+        for (
+          tournament::player_index vertex{ };
+          vertex < keptVertices.size();
+          ++vertex)
         {
-          const unsigned int newBits =
-            utility::typesizes::bitsToRepresent<unsigned int>(repeatedScores);
-          scoreGroupShifts[currentScore] = scoreGroupsShift;
-          maxScoreGroupSize = std::max(maxScoreGroupSize, repeatedScores);
-          repeatedScores = 0;
-          scoreGroupsShift += newBits;
-          assert(scoreGroupsShift >= newBits);
+          result.addVertex();
+          newPlayersByVertex.push_back(playersByVertex[keptVertices[vertex]]);
+          newMatched.push_back(matched[keptVertices[vertex]]);
+          edgeWeights.clear();
+          for (
+            tournament::player_index neighbor{ };
+            neighbor < vertex;
+            ++neighbor)
+          {
+            edgeWeights.push_back(
+              matchingComputer.getEdgeWeight(
+                keptVertices[vertex],
+                keptVertices[neighbor]));
+          }
+          result.setEdgeWeights(vertex, neighbors, edgeWeights);
+          neighbors.push_back(vertex);
+        }
+
+        for (tournament::player_index &vertex : vertexIndices)
+        {
+          vertex =
+            vertex < scoreGroupBeginVertex
+              ? std::lower_bound(
+                  keptVertices.begin(),
+                  keptVertices.begin() + movedDownPlayers,
+                  vertex
+                ) - keptVertices.begin()
+              : vertex - scoreGroupBeginVertex + movedDownPlayers;
         }
+        scoreGroupBeginVertex = movedDownPlayers;
+        playersByVertex = std::move(newPlayersByVertex);
+        matched = std::move(newMatched);
+        retiredStats += matchingComputer.getStats();
+        matchingComputer = std::move(result);
       }
 
-      const unsigned int scoreGroupSizeBits =
-        utility::typesizes::bitsToRepresent<unsigned int>(maxScoreGroupSize);
+#endif
+      /**
+       * Pair the players in sortedPlayers, using edge_weight for the weights
+       * of the matching graph. maxEdgeWeight is the upper bound computed by
+       * computeEdgeWeight<true>, and must fit in edge_weight.
+       */
+      template <typename edge_weight>
+      std::list<Pairing> pairSortedPlayers(
+        const tournament::Tournament &tournament,
+        std::ostream *const ostream,
+        const std::vector<const tournament::Player *> &sortedPlayers,
+        const PairingCriteria &criteria,
+        const unsigned int scoreGroupSizeBits,
+        const score_group_shift scoreGroupsShift,
+        const std::unordered_map<tournament::points, score_group_shift>
+          &scoreGroupShifts,
+        std::unordered_map<tournament::round_index, tournament::player_index>
+          unplayedGameRanks,
+        edge_weight maxEdgeWeight)
+      {
+        typedef matching::Computer<edge_weight> matching_computer;
 
-      std::unordered_map<tournament::round_index, tournament::player_index>
-        unplayedGameRanks{ };
+        // Initialize the matching computer used to optimize the pairings
+        matching_computer matchingComputer(sortedPlayers.size(), maxEdgeWeight);
 
-      // Compute an edge weight upper bound.
-      matching_computer::edge_weight maxEdgeWeight{ 0u };
-      computeEdgeWeight<true>(
-        *sortedPlayers.front(),
-        *sortedPlayers.front(),
-        true,
-        false,
-        0u,
-        tournament,
-        forbiddenPairs,
-        scoreGroupSizeBits,
-        scoreGroupsShift,
-        scoreGroupShifts,
-        false,
-        unplayedGameRanks,
-        maxEdgeWeight);
+        // Start the threads used for computing the base edge weights.
+        const std::unique_ptr<utility::threadpool::ThreadPool> threadPool{
+          PAIRING_THREADS > 1
+            ? std::make_unique<utility::threadpool::ThreadPool>(
+                PAIRING_THREADS)
+            : nullptr
+        };
 
-      // Initialize the matching computer used to optimize the pairings
-      matching_computer matchingComputer(sortedPlayers.size(), maxEdgeWeight);
-
-      // Set edge weights to enforce completability.
-      if (sortedPlayers.size() > ~matching_computer::size_type{ })
-      {
-        throw std::length_error("");
-      }
-      for (
-        tournament::player_index playerIndex{ };
-        playerIndex < sortedPlayers.size();
-        ++playerIndex)
-      {
-        matchingComputer.addVertex();
-      }
+        // Set edge weights to enforce completability.
+        if (sortedPlayers.size() > ~typename matching_computer::size_type{ })
+        {
+          throw std::length_error("");
+        }
+        for (
+          tournament::player_index playerIndex{ };
+          playerIndex < sortedPlayers.size();
+          ++playerIndex)
+        {
+          matchingComputer.addVertex();
+        }
 
-      {
-        tournament::player_index playerIndex{ };
-        for (const tournament::Player *const player : sortedPlayers)
         {
-          const tournament::points playerScore =
-            player->scoreWithAcceleration(tournament);
-          tournament::player_index opponentIndex{ };
-          for (const tournament::Player *const opponent : sortedPlayers)
+          /**
+           * The vertexes of the players before the current one.
+           */
+          std::vector<tournament::player_index> opponentVertices;
+          std::vector<edge_weight> edgeWeights;
+          tournament::player_index playerIndex{ };
+          for (const tournament::Player *const player : sortedPlayers)
           {
-            if (opponentIndex == playerIndex)
-            {
-              break;
-            }
-            if (sortedPlayers.size() & 1u)
+            const tournament::points playerScore =
+              player->scoreWithAcceleration(tournament);
+            edgeWeights.clear();
+            tournament::player_index opponentIndex{ };
+            for (const tournament::Player *const opponent : sortedPlayers)
             {
-              matching_computer::edge_weight edgeWeight{ maxEdgeWeight };
-              edgeWeight &= 0u;
-              if (compatible(*player, *opponent, tournament, forbiddenPairs))
+              if (opponentIndex == playerIndex)
               {
-                edgeWeight |=
-                  1u
-                    + !eligibleForBye(*player, tournament)
-                    + !eligibleForBye(*opponent, tournament);
-                edgeWeight <<= scoreGroupsShift;
-                edgeWeight |=
-                  scoreGroupShifts.find(playerScore)->second
-                    + scoreGroupShifts.find(
-                          opponent->scoreWithAcceleration(tournament)
-                        )->second;
-                edgeWeight <<= scoreGroupSizeBits;
-                edgeWeight |=
-                  player->scoreWithAcceleration(tournament)
-                    >= sortedPlayers.front()->scoreWithAcceleration(tournament);
+                break;
               }
-              matchingComputer.setEdgeWeight(
-                playerIndex,
-                opponentIndex,
-                std::move(edgeWeight));
-            }
-            else
-            {
-              matchingComputer
-                .setEdgeWeight(
-                  playerIndex,
-                  opponentIndex,
+              if (sortedPlayers.size() & 1u)
+              {
+                edge_weight edgeWeight{ maxEdgeWeight };
+                edgeWeight &= 0u;
+                if (
+                  criteria.getPairCriteria(*player, *opponent)
+                    & PairingCriteria::PAIR_COMPATIBLE)
+                {
+                  edgeWeight |=
+                    1u
+                      + !criteria.isEligibleForBye(*player)
+                      + !criteria.isEligibleForBye(*opponent);
+                  edgeWeight <<= scoreGroupsShift;
+                  edgeWeight |=
+                    scoreGroupShifts.find(playerScore)->second
+                      + scoreGroupShifts.find(
+                            opponent->scoreWithAcceleration(tournament)
+                          )->second;
+                  edgeWeight <<= scoreGroupSizeBits;
+                  edgeWeight |=
+                    player->scoreWithAcceleration(tournament)
+                      >= sortedPlayers.front()
+                           ->scoreWithAcceleration(tournament);
+                }
+                edgeWeights.push_back(std::move(edgeWeight));
+              }
+              else
+              {
+                edgeWeights.push_back(
                   computeEdgeWeight(
                     *opponent,
                     *player,
@@ -802,888 +1112,1180 @@ namespace swisssystems
                     false,
                     0u,
                     tournament,
-                    forbiddenPairs,
+                    criteria,
                     scoreGroupSizeBits,
                     scoreGroupsShift,
                     scoreGroupShifts,
                     false,
                     unplayedGameRanks,
                     maxEdgeWeight));
+              }
+              ++opponentIndex;
             }
-            ++opponentIndex;
-          }
-          ++playerIndex;
-        }
-      }
-
-      // Check whether a pairing is possible initially, determine score of bye
-      // assignee, and check whether C9 (minimise unplayed games of bye
-      // assignee) takes effect in the first bracket.
-      tournament::points byeAssigneeScore{ };
-      bool isSingleDownfloaterTheByeAssignee;
-      {
-        matchingComputer.computeMatching();
-        const std::vector<tournament::player_index> matching =
-          matchingComputer.getMatching();
-        if (!matchingIsComplete(matching, tournament, sortedPlayers))
-        {
-          if (ostream)
-          {
-            printChecklist(tournament, sortedPlayers, *ostream);
+            matchingComputer.setEdgeWeights(
+              playerIndex,
+              opponentVertices,
+              edgeWeights);
+            opponentVertices.push_back(playerIndex);
+            ++playerIndex;
           }
-          throw NoValidPairingException(
-            "The players could not be simultaneously matched while satisfying "
-            "all absolute criteria.");
         }
 
-        if (sortedPlayers.size() & 1u)
+        // Check whether a pairing is possible initially, determine score of bye
+        // assignee, and check whether C9 (minimise unplayed games of bye
+        // assignee) takes effect in the first bracket.
+        tournament::points byeAssigneeScore{ };
+        bool isSingleDownfloaterTheByeAssignee;
         {
-          tournament::player_index playerIndex{ };
-          for (const tournament::Player *const player : sortedPlayers)
+          matchingComputer.computeMatching(
+            shouldFilterOuterOuterScans(matchingComputer));
+          const std::vector<tournament::player_index> matching =
+            matchingComputer.getMatching();
+          if (!matchingIsComplete(matching, tournament, sortedPlayers))
           {
-            if (matching[playerIndex] == playerIndex)
+            if (ostream)
             {
-              byeAssigneeScore = player->scoreWithAcceleration(tournament);
-              break;
+              printChecklist(tournament, sortedPlayers, *ostream);
             }
-            ++playerIndex;
+            throw NoValidPairingException(
+              "The players could not be simultaneously matched while "
+              "satisfying all absolute criteria.");
           }
 
-          auto topScore = sortedPlayers.front()->scoreWithAcceleration(tournament);
-          if (byeAssigneeScore >= topScore)
+          if (sortedPlayers.size() & 1u)
           {
-            isSingleDownfloaterTheByeAssignee = true;
-            playerIndex = 0u;
+            tournament::player_index playerIndex{ };
             for (const tournament::Player *const player : sortedPlayers)
             {
-              if (player->scoreWithAcceleration(tournament) < topScore)
+              if (matching[playerIndex] == playerIndex)
               {
+                byeAssigneeScore = player->scoreWithAcceleration(tournament);
                 break;
               }
-              if (
-                sortedPlayers[matching[playerIndex]]
-                    ->scoreWithAcceleration(tournament)
-                  < topScore)
+              ++playerIndex;
+            }
+
+            auto topScore = sortedPlayers.front()->scoreWithAcceleration(tournament);
+            if (byeAssigneeScore >= topScore)
+            {
+              isSingleDownfloaterTheByeAssignee = true;
+              playerIndex = 0u;
+              for (const tournament::Player *const player : sortedPlayers)
               {
-                isSingleDownfloaterTheByeAssignee = false;
-                break;
+                if (player->scoreWithAcceleration(tournament) < topScore)
+                {
+                  break;
+                }
+                if (
+                  sortedPlayers[matching[playerIndex]]
+                      ->scoreWithAcceleration(tournament)
+                    < topScore)
+                {
+                  isSingleDownfloaterTheByeAssignee = false;
+                  break;
+                }
+                ++playerIndex;
               }
-              ++playerIndex;
             }
-          }
-          else
-          {
-            isSingleDownfloaterTheByeAssignee = false;
-          }
+            else
+            {
+              isSingleDownfloaterTheByeAssignee = false;
+            }
 
-          std::vector<tournament::round_index> playedGameCounts{ };
-          for (const tournament::Player *const player : sortedPlayers)
-          {
-            if (player->scoreWithAcceleration(tournament) == byeAssigneeScore)
+            std::vector<tournament::round_index> playedGameCounts{ };
+            for (const tournament::Player *const player : sortedPlayers)
             {
-              playedGameCounts.emplace_back(player->playedGames);
+              if (player->scoreWithAcceleration(tournament) == byeAssigneeScore)
+              {
+                playedGameCounts.emplace_back(player->playedGames);
+              }
+            }
+            std::sort(playedGameCounts.rbegin(), playedGameCounts.rend());
+            tournament::player_index rank{ };
+            for (const tournament::round_index playedGames : playedGameCounts)
+            {
+              unplayedGameRanks[playedGames] = rank++;
             }
-          }
-          std::sort(playedGameCounts.rbegin(), playedGameCounts.rend());
-          tournament::player_index rank{ };
-          for (const tournament::round_index playedGames : playedGameCounts)
-          {
-            unplayedGameRanks[playedGames] = rank++;
-          }
 
-          playerIndex = 0u;
-          for (const tournament::Player *const player : sortedPlayers)
-          {
-            tournament::player_index opponentIndex{ };
-            for (const tournament::Player *const opponent : sortedPlayers)
+            playerIndex = 0u;
+            std::vector<tournament::player_index> opponentVertices;
+            std::vector<edge_weight> edgeWeights;
+            for (const tournament::Player *const player : sortedPlayers)
             {
-              if (opponentIndex == playerIndex)
+              edgeWeights.clear();
+              tournament::player_index opponentIndex{ };
+              for (const tournament::Player *const opponent : sortedPlayers)
               {
-                break;
+                if (opponentIndex == playerIndex)
+                {
+                  break;
+                }
+                edgeWeights.push_back(
+                  computeEdgeWeight(
+                    *opponent,
+                    *player,
+                    false,
+                    false,
+                    byeAssigneeScore,
+                    tournament,
+                    criteria,
+                    scoreGroupSizeBits,
+                    scoreGroupsShift,
+                    scoreGroupShifts,
+                    isSingleDownfloaterTheByeAssignee,
+                    unplayedGameRanks,
+                    maxEdgeWeight));
+                ++opponentIndex;
               }
-              matchingComputer.setEdgeWeight(
+              matchingComputer.setEdgeWeights(
                 playerIndex,
-                opponentIndex,
-                computeEdgeWeight(
-                  *opponent,
-                  *player,
-                  false,
-                  false,
-                  byeAssigneeScore,
-                  tournament,
-                  forbiddenPairs,
-                  scoreGroupSizeBits,
-                  scoreGroupsShift,
-                  scoreGroupShifts,
-                  isSingleDownfloaterTheByeAssignee,
-                  unplayedGameRanks,
-                  maxEdgeWeight));
-              ++opponentIndex;
+                opponentVertices,
+                edgeWeights);
+              opponentVertices.push_back(playerIndex);
+              ++playerIndex;
             }
-            ++playerIndex;
+          }
+          else
+          {
+            isSingleDownfloaterTheByeAssignee = false;
           }
         }
-        else
-        {
-          isSingleDownfloaterTheByeAssignee = false;
-        }
-      }
-
-      /**
-       * A vector indicating the match for each player, indexed by player ID.
-       * Unmatched players are indicated with null pointers.
-       */
-      std::vector<const tournament::Player *>
-        matchingById(tournament.players.size());
-
-      /**
-       * Given the index of a player among those in the current pairing bracket
-       * or the next, stores the pointer to the Player.
-       */
-      std::vector<const tournament::Player *> playersByIndex;
-      /**
-       * Given the index of a player among those in the current pairing bracket
-       * or the next, stores the index of the player in matchingComputer, that
-       * is, the index in sortedPlayers.
-       */
-      std::vector<tournament::player_index> vertexIndices;
-      /**
-       * An iterator pointing to the beginning of the next score group.
-       */
-      decltype(sortedPlayers)::const_iterator nextScoreGroupIterator =
-        sortedPlayers.begin();
-      while (
-        nextScoreGroupIterator != sortedPlayers.end()
-          && (*nextScoreGroupIterator)->scoreWithAcceleration(tournament)
-              >= sortedPlayers.front()->scoreWithAcceleration(tournament))
-      {
-        playersByIndex.push_back(*nextScoreGroupIterator);
-        vertexIndices.push_back(vertexIndices.size());
-        ++nextScoreGroupIterator;
-      }
 
-      /**
-       * Stores whether the player will be matched. The vector is indexed by
-       * index in sortedPlayers.
-       */
-      std::vector<bool> matched(sortedPlayers.size());
-
-      /**
-       * The number of moved down players in the current pairing bracket.
-       */
-      tournament::player_index scoreGroupBegin{ };
-      /**
-       * The index of the first player in sortedPlayers from the current
-       * bracket's score group.
-       */
-      tournament::player_index scoreGroupBeginVertex{ };
+        /**
+         * A vector indicating the match for each player, indexed by player ID.
+         * Unmatched players are indicated with null pointers.
+         */
+        std::vector<const tournament::Player *>
+          matchingById(tournament.players.size());
 
-      while (
-        playersByIndex.size() > 1u
-          || nextScoreGroupIterator != sortedPlayers.end())
-      {
         /**
-         * The number of players in the current pairing bracket.
+         * Given the index of a player among those in the current pairing
+         * bracket or the next, stores the pointer to the Player.
          */
-        const tournament::player_index nextScoreGroupBegin =
-          playersByIndex.size();
+        std::vector<const tournament::Player *> playersByIndex;
         /**
-         * The index of the first player in sortedPlayers from the next score
-         * group.
+         * Given the index of a player among those in the current pairing
+         * bracket or the next, stores the index of the player in
+         * matchingComputer, that is, the index in sortedPlayers.
          */
-        const tournament::player_index nextScoreGroupBeginVertex =
-          scoreGroupBeginVertex + (nextScoreGroupBegin - scoreGroupBegin);
+        std::vector<tournament::player_index> vertexIndices;
         /**
-         * Save the iterator to the beginning of the next score group.
+         * An iterator pointing to the beginning of the next score group.
          */
-        const decltype(sortedPlayers)::const_iterator scoreGroupIterator =
-          nextScoreGroupIterator;
+        auto nextScoreGroupIterator = sortedPlayers.begin();
         while (
           nextScoreGroupIterator != sortedPlayers.end()
-            && ((*nextScoreGroupIterator)->scoreWithAcceleration(tournament)
-                  >= (*scoreGroupIterator)->scoreWithAcceleration(tournament)))
+            && (*nextScoreGroupIterator)->scoreWithAcceleration(tournament)
+                >= sortedPlayers.front()->scoreWithAcceleration(tournament))
         {
           playersByIndex.push_back(*nextScoreGroupIterator);
-          vertexIndices.push_back(vertexIndices.back() + 1u);
+          vertexIndices.push_back(vertexIndices.size());
           ++nextScoreGroupIterator;
         }
 
-        std::vector<std::vector<matching_computer::edge_weight>>
-            baseEdgeWeights =
-          computeBaseEdgeWeights(
-            maxEdgeWeight,
-            playersByIndex,
-            scoreGroupBegin,
-            nextScoreGroupBegin,
-            byeAssigneeScore,
-            tournament,
-            forbiddenPairs,
-            scoreGroupSizeBits,
-            scoreGroupsShift,
-            scoreGroupShifts,
-            isSingleDownfloaterTheByeAssignee,
-            unplayedGameRanks);
-
-        // Update the matching computer for optimizing the pairing in the
-        // current pairing bracket
+        /**
+         * Stores whether the player will be matched. The vector is indexed by
+         * index in sortedPlayers.
+         */
+        std::vector<bool> matched(sortedPlayers.size());
+
+        /**
+         * The number of moved down players in the current pairing bracket.
+         */
+        tournament::player_index scoreGroupBegin{ };
+        /**
+         * The index of the first player in sortedPlayers from the current
+         * bracket's score group.
+         */
+        tournament::player_index scoreGroupBeginVertex{ };
+        /**
+         * Given the index of a vertex in matchingComputer, stores the pointer
+         * to the Player. This is sortedPlayers unless the matching computer
+         * has been compacted.
+         */
+        std::vector<const tournament::Player *> playersByVertex =
+          sortedPlayers;
+        /**
+         * The statistics of the matching computers replaced by compaction.
+         */
+        matching::Stats retiredStats;
+
+        while (
+          playersByIndex.size() > 1u
+            || nextScoreGroupIterator != sortedPlayers.end())
         {
-          auto opponentIterator = vertexIndices.begin();
-          for (
-            const std::vector<matching_computer::edge_weight> &opponentVector
-              : baseEdgeWeights)
+          /**
+           * The number of players in the current pairing bracket.
+           */
+          const tournament::player_index nextScoreGroupBegin =
+            playersByIndex.size();
+          /**
+           * The index of the first player in sortedPlayers from the next score
+           * group.
+           */
+          const tournament::player_index nextScoreGroupBeginVertex =
+            scoreGroupBeginVertex + (nextScoreGroupBegin - scoreGroupBegin);
+          /**
+           * Save the iterator to the beginning of the next score group.
+           */
+          const auto scoreGroupIterator = nextScoreGroupIterator;
+          while (
+            nextScoreGroupIterator != sortedPlayers.end()
+              && ((*nextScoreGroupIterator)->scoreWithAcceleration(tournament)
+                    >= (*scoreGroupIterator)
+                         ->scoreWithAcceleration(tournament)))
           {
-            const tournament::player_index opponentVertex = *opponentIterator;
-            auto playerIterator = vertexIndices.begin();
+            playersByIndex.push_back(*nextScoreGroupIterator);
+            vertexIndices.push_back(vertexIndices.back() + 1u);
+            ++nextScoreGroupIterator;
+          }
+
+          std::vector<std::vector<edge_weight>>
+              baseEdgeWeights =
+            computeBaseEdgeWeights(
+              threadPool.get(),
+              maxEdgeWeight,
+              playersByIndex,
+              scoreGroupBegin,
+              nextScoreGroupBegin,
+              byeAssigneeScore,
+              tournament,
+              criteria,
+              scoreGroupSizeBits,
+              scoreGroupsShift,
+              scoreGroupShifts,
+              isSingleDownfloaterTheByeAssignee,
+              unplayedGameRanks);
+
+          // Update the matching computer for optimizing the pairing in the
+          // current pairing bracket
+          {
+            auto opponentIterator = vertexIndices.begin();
             for (
-              const matching_computer::edge_weight &edgeWeight : opponentVector)
+              const std::vector<edge_weight> &opponentVector
+                : baseEdgeWeights)
             {
-              matchingComputer.setEdgeWeight(
-                opponentVertex,
-                *playerIterator,
-                edgeWeight);
-              ++playerIterator;
+              matchingComputer.setEdgeWeights(
+                *opponentIterator,
+                vertexIndices,
+                opponentVector);
+              ++opponentIterator;
             }
-            ++opponentIterator;
           }
-        }
-
-        /**
-         * A function used to calculate an edge weight modified for pairing
-         * homogeneous brackets or remainders with some of the exchange
-         * preferences.
-         */
-        const auto edgeWeightComputer =
-          [&baseEdgeWeights, scoreGroupSizeBits](
-            const tournament::player_index smallerPlayerIndex,
-            const tournament::player_index largerPlayerIndex,
-            const tournament::player_index smallerPlayerRemainderIndex,
-            const tournament::player_index remainderPairs)
-          {
-            matching_computer::edge_weight result =
-              baseEdgeWeights[largerPlayerIndex][smallerPlayerIndex];
 
-            if (result)
+          /**
+           * A function used to calculate an edge weight modified for pairing
+           * homogeneous brackets or remainders with some of the exchange
+           * preferences.
+           */
+          const auto edgeWeightComputer =
+            [&baseEdgeWeights, scoreGroupSizeBits](
+              const tournament::player_index smallerPlayerIndex,
+              const tournament::player_index largerPlayerIndex,
+              const tournament::player_index smallerPlayerRemainderIndex,
+              const tournament::player_index remainderPairs)
             {
-              matching_computer::edge_weight addend = result & 0u;
-
-              // Minimize the number of exchanges.
-              addend |= smallerPlayerRemainderIndex < remainderPairs;
-
-              // Minimize the difference of the exchanged branch scoring
-              // numbers.
-              addend <<= scoreGroupSizeBits;
-              addend <<= scoreGroupSizeBits;
-              addend -= smallerPlayerRemainderIndex;
+              edge_weight result =
+                baseEdgeWeights[largerPlayerIndex][smallerPlayerIndex];
 
-              // Leave room for optimizing based on which players are exchanged.
-              addend <<= 1u;
+              if (result)
+              {
+                edge_weight addend = result & 0u;
 
-              result += addend;
-            }
+                // Minimize the number of exchanges.
+                addend |= smallerPlayerRemainderIndex < remainderPairs;
 
-            return result;
-          };
+                // Minimize the difference of the exchanged branch scoring
+                // numbers.
+                addend <<= scoreGroupSizeBits;
+                addend <<= scoreGroupSizeBits;
+                addend -= smallerPlayerRemainderIndex;
 
-        matchingComputer.computeMatching();
+                // Leave room for optimizing based on which players are
+                // exchanged.
+                addend <<= 1u;
 
-        auto stableMatching = matchingComputer.getMatching();
+                result += addend;
+              }
 
-        // Choose the moved down players to pair in the current pairing bracket.
+              return result;
+            };
 
-        /**
-         * The score of the moved down players we are currently considering.
-         */
-        tournament::points movedDownScoreGroup;
-        /**
-         * The number of moved down players with score movedDownScoreGroup that
-         * we have not considered yet.
-         */
-        tournament::player_index remainingMovedDownScoreGroupPlayers;
-        /**
-         * The number of moved down players with score movedDownScoreGroup that
-         * we will be able to match among those we have not considered yet.
-         */
-        tournament::player_index remainingMatchedMovedDownScoreGroupPlayers;
-        for (
-          tournament::player_index playerIndex = 0;
-          playerIndex < scoreGroupBegin;
-          ++playerIndex)
-        {
-          if (
-            !playerIndex
-              || playersByIndex[playerIndex]->scoreWithAcceleration(tournament)
-                  < movedDownScoreGroup)
+          /**
+           * Whether this bracket's computations filter their outer-outer
+           * scans, judged from the edge weights at the start of the bracket.
+           */
+          const bool filterOuterOuterScans =
+            shouldFilterOuterOuterScans(matchingComputer);
+
+          matchingComputer.computeMatching(filterOuterOuterScans);
+
+          auto stableMatching = matchingComputer.getMatching();
+
+          // Choose the moved down players to pair in the current pairing
+          // bracket.
+
+          /**
+           * The score of the moved down players we are currently considering.
+           */
+          tournament::points movedDownScoreGroup;
+          /**
+           * The number of moved down players with score movedDownScoreGroup
+           * that we have not considered yet.
+           */
+          tournament::player_index remainingMovedDownScoreGroupPlayers;
+          /**
+           * The number of moved down players with score movedDownScoreGroup
+           * that we will be able to match among those we have not considered
+           * yet.
+           */
+          tournament::player_index remainingMatchedMovedDownScoreGroupPlayers;
+          /**
+           * Whether no edge weight has changed since the matching was last
+           * computed, in which case the dual variables prove that it is
+           * optimal.
+           */
+          bool matchingIsSolved = true;
+          for (
+            tournament::player_index playerIndex = 0;
+            playerIndex < scoreGroupBegin;
+            ++playerIndex)
           {
-            // Count the number of moved down players with the same score as
-            // playerIndex, as well as the number of these that can be matched.
-            movedDownScoreGroup =
-              playersByIndex[playerIndex]->scoreWithAcceleration(tournament);
-            remainingMatchedMovedDownScoreGroupPlayers = 0;
-            remainingMovedDownScoreGroupPlayers = 0;
-            for (
-              tournament::player_index movedDownPlayerIndex = playerIndex;
-              playersByIndex[movedDownPlayerIndex]
-                  ->scoreWithAcceleration(tournament)
-                >= movedDownScoreGroup;
-              ++movedDownPlayerIndex)
+            if (
+              !playerIndex
+                || playersByIndex[playerIndex]
+                       ->scoreWithAcceleration(tournament)
+                     < movedDownScoreGroup)
             {
-              ++remainingMovedDownScoreGroupPlayers;
-              const tournament::player_index movedDownPlayerVertex =
-                vertexIndices[movedDownPlayerIndex];
-              if (
-                stableMatching[movedDownPlayerVertex] >= scoreGroupBeginVertex
-                  && stableMatching[movedDownPlayerVertex] < nextScoreGroupBeginVertex)
+              // Count the number of moved down players with the same score as
+              // playerIndex, as well as the number of these that can be
+              // matched.
+              movedDownScoreGroup =
+                playersByIndex[playerIndex]->scoreWithAcceleration(tournament);
+              remainingMatchedMovedDownScoreGroupPlayers = 0;
+              remainingMovedDownScoreGroupPlayers = 0;
+              for (
+                tournament::player_index movedDownPlayerIndex = playerIndex;
+                playersByIndex[movedDownPlayerIndex]
+                    ->scoreWithAcceleration(tournament)
+                  >= movedDownScoreGroup;
+                ++movedDownPlayerIndex)
               {
-                ++remainingMatchedMovedDownScoreGroupPlayers;
+                ++remainingMovedDownScoreGroupPlayers;
+                const tournament::player_index movedDownPlayerVertex =
+                  vertexIndices[movedDownPlayerIndex];
+                if (
+                  stableMatching[movedDownPlayerVertex] >= scoreGroupBeginVertex
+                    && stableMatching[movedDownPlayerVertex] < nextScoreGroupBeginVertex)
+                {
+                  ++remainingMatchedMovedDownScoreGroupPlayers;
+                }
               }
             }
-          }
-          if (!remainingMatchedMovedDownScoreGroupPlayers)
-          {
-            continue;
-          }
-          const tournament::player_index playerVertex = vertexIndices[playerIndex];
-          if (
-            remainingMovedDownScoreGroupPlayers
-              <= remainingMatchedMovedDownScoreGroupPlayers)
-          {
-            matched[playerVertex] = true;
-            continue;
-          }
-          --remainingMovedDownScoreGroupPlayers;
-          if (
-            stableMatching[playerVertex] < scoreGroupBeginVertex
-              || stableMatching[playerVertex] >= nextScoreGroupBeginVertex)
-          {
-            // Try to match the player.
-            for (
-              tournament::player_index opponentIndex = scoreGroupBegin;
-              opponentIndex < nextScoreGroupBegin;
-              ++opponentIndex)
+            if (!remainingMatchedMovedDownScoreGroupPlayers)
             {
-              matching_computer::edge_weight edgeWeight =
-                baseEdgeWeights[opponentIndex][playerIndex];
-              if (edgeWeight)
+              continue;
+            }
+            const tournament::player_index playerVertex = vertexIndices[playerIndex];
+            if (
+              remainingMovedDownScoreGroupPlayers
+                <= remainingMatchedMovedDownScoreGroupPlayers)
+            {
+              matched[playerVertex] = true;
+              continue;
+            }
+            --remainingMovedDownScoreGroupPlayers;
+            if (
+              stableMatching[playerVertex] < scoreGroupBeginVertex
+                || stableMatching[playerVertex] >= nextScoreGroupBeginVertex)
+            {
+              // Try to match the player.
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              for (
+                tournament::player_index opponentIndex = scoreGroupBegin;
+                opponentIndex < nextScoreGroupBegin;
+                ++opponentIndex)
               {
-                edgeWeight |= 1u;
-                matchingComputer.setEdgeWeight(
-                  playerVertex,
-                  vertexIndices[opponentIndex],
-                  std::move(edgeWeight));
+                edge_weight edgeWeight =
+                  baseEdgeWeights[opponentIndex][playerIndex];
+                if (edgeWeight)
+                {
+                  edgeWeight |= 1u;
+                  opponentVertices.push_back(vertexIndices[opponentIndex]);
+                  edgeWeights.push_back(std::move(edgeWeight));
+                }
               }
-            }
 
-            matchingComputer.computeMatching();
+              // Only solve again if the dual variables do not already show
+              // that the player cannot be matched in the bracket. They can
+              // only show this while they still belong to a solved matching.
+              if (
+                !matchingIsSolved
+                  || !matchingComputer.setEdgeWeightsIfOptimal(
+                        playerVertex,
+                        opponentVertices,
+                        edgeWeights))
+              {
+                matchingComputer.setEdgeWeights(
+                  playerVertex,
+                  opponentVertices,
+                  edgeWeights);
+
+                matchingComputer.computeMatching(filterOuterOuterScans);
+                matchingIsSolved = true;
 
-            stableMatching = matchingComputer.getMatching();
+                stableMatching = matchingComputer.getMatching();
+              }
+            }
+            if (
+              stableMatching[playerVertex] >= scoreGroupBeginVertex
+                && stableMatching[playerVertex] < nextScoreGroupBeginVertex)
+            {
+              // Finalize the fact that this player will be matched.
+              matched[playerVertex] = true;
+              --remainingMatchedMovedDownScoreGroupPlayers;
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              for (
+                tournament::player_index opponentIndex = scoreGroupBegin;
+                opponentIndex < nextScoreGroupBegin;
+                ++opponentIndex)
+              {
+                edge_weight edgeWeight =
+                  baseEdgeWeights[opponentIndex][playerIndex];
+                if (edgeWeight)
+                {
+                  edgeWeight |= nextScoreGroupBegin - scoreGroupBegin;
+                  ++edgeWeight;
+                  opponentVertices.push_back(vertexIndices[opponentIndex]);
+                  edgeWeights.push_back(std::move(edgeWeight));
+                }
+              }
+              matchingComputer.setEdgeWeights(
+                playerVertex,
+                opponentVertices,
+                edgeWeights);
+              matchingIsSolved = false;
+            }
           }
-          if (
-            stableMatching[playerVertex] >= scoreGroupBeginVertex
-              && stableMatching[playerVertex] < nextScoreGroupBeginVertex)
+
+          // Choose the opponents of the moved down players.
+          for (
+            tournament::player_index playerIndex = 0;
+            playerIndex < scoreGroupBegin;
+            ++playerIndex)
           {
-            // Finalize the fact that this player will be matched.
-            matched[playerVertex] = true;
-            --remainingMatchedMovedDownScoreGroupPlayers;
+            const tournament::player_index playerVertex = vertexIndices[playerIndex];
+            if (!matched[playerVertex])
+            {
+              continue;
+            }
+            edge_weight addend =
+              (maxEdgeWeight & 0u) | playersByIndex.size();
+            std::vector<tournament::player_index> opponentVertices;
+            std::vector<edge_weight> edgeWeights;
             for (
-              tournament::player_index opponentIndex = scoreGroupBegin;
-              opponentIndex < nextScoreGroupBegin;
-              ++opponentIndex)
+              tournament::player_index opponentIndex = nextScoreGroupBegin - 1u;
+              opponentIndex >= scoreGroupBegin;
+              --opponentIndex)
             {
-              matching_computer::edge_weight edgeWeight =
+              const tournament::player_index opponentVertex = vertexIndices[opponentIndex];
+              if (matched[opponentVertex])
+              {
+                continue;
+              }
+              edge_weight edgeWeight =
                 baseEdgeWeights[opponentIndex][playerIndex];
               if (edgeWeight)
               {
-                edgeWeight |= nextScoreGroupBegin - scoreGroupBegin;
-                ++edgeWeight;
-                matchingComputer.setEdgeWeight(
-                  playerVertex,
-                  vertexIndices[opponentIndex],
-                  std::move(edgeWeight));
+                edgeWeight += addend;
+                opponentVertices.push_back(opponentVertex);
+                edgeWeights.push_back(std::move(edgeWeight));
+                ++addend;
               }
             }
-          }
-        }
+            matchingComputer.setEdgeWeights(
+              playerVertex,
+              opponentVertices,
+              edgeWeights);
 
-        // Choose the opponents of the moved down players.
-        for (
-          tournament::player_index playerIndex = 0;
-          playerIndex < scoreGroupBegin;
-          ++playerIndex)
-        {
-          const tournament::player_index playerVertex = vertexIndices[playerIndex];
-          if (!matched[playerVertex])
-          {
-            continue;
+            matchingComputer.computeMatching(filterOuterOuterScans);
+            stableMatching = matchingComputer.getMatching();
+
+            // Finalize the pairing.
+            const tournament::player_index matchVertex =
+              stableMatching[playerVertex];
+            matched[matchVertex] = true;
+            finalizePair(
+              playerVertex,
+              matchVertex,
+              matchingComputer,
+              maxEdgeWeight);
           }
-          matching_computer::edge_weight addend =
-            (maxEdgeWeight & 0u) | playersByIndex.size();
+
+          /**
+           * Collects the player indexes of the players in the remainder.
+           */
+          std::deque<tournament::player_index> remainder;
+
+          /**
+           * The number of pairs that can be formed in the remainder.
+           */
+          tournament::player_index remainderPairs{ };
+
+          /**
+           * Initialize remainder and remainderPairs.
+           */
           for (
-            tournament::player_index opponentIndex = nextScoreGroupBegin - 1u;
-            opponentIndex >= scoreGroupBegin;
-            --opponentIndex)
+            tournament::player_index playerIndex = scoreGroupBegin;
+            playerIndex < nextScoreGroupBegin;
+            ++playerIndex)
           {
-            const tournament::player_index opponentVertex = vertexIndices[opponentIndex];
-            if (matched[opponentVertex])
+            const tournament::player_index playerVertex = vertexIndices[playerIndex];
+            if (stableMatching[playerVertex] < scoreGroupBeginVertex)
             {
               continue;
             }
-            matching_computer::edge_weight edgeWeight =
-              baseEdgeWeights[opponentIndex][playerIndex];
-            if (edgeWeight)
+            remainder.push_back(playerIndex);
+            if (stableMatching[playerVertex] < playerVertex)
             {
-              edgeWeight += addend;
-              matchingComputer.setEdgeWeight(
-                playerVertex,
-                opponentVertex,
-                std::move(edgeWeight));
-              ++addend;
+              ++remainderPairs;
             }
           }
-
-          matchingComputer.computeMatching();
-          stableMatching = matchingComputer.getMatching();
-
-          // Finalize the pairing.
-          const tournament::player_index matchVertex =
-            stableMatching[playerVertex];
-          matched[matchVertex] = true;
-          finalizePair(
-            playerVertex,
-            matchVertex,
-            matchingComputer,
-            maxEdgeWeight);
-        }
-
-        /**
-         * Collects the player indexes of the players in the remainder.
-         */
-        std::deque<tournament::player_index> remainder;
-
-        /**
-         * The number of pairs that can be formed in the remainder.
-         */
-        tournament::player_index remainderPairs{ };
-
-        /**
-         * Initialize remainder and remainderPairs.
-         */
-        for (
-          tournament::player_index playerIndex = scoreGroupBegin;
-          playerIndex < nextScoreGroupBegin;
-          ++playerIndex)
-        {
-          const tournament::player_index playerVertex = vertexIndices[playerIndex];
-          if (stableMatching[playerVertex] < scoreGroupBeginVertex)
-          {
-            continue;
-          }
-          remainder.push_back(playerIndex);
-          if (stableMatching[playerVertex] < playerVertex)
+          /**
+           * An iterator to the first element in remainder that is in the lower
+           * group of players.
+           */
+          decltype(remainder)::const_iterator firstGroupEnd =
+            std::next(remainder.begin(), remainderPairs);
+
+          // Update edge weights to minimize exchanged players and the
+          // differences of exchanged BSNs.
           {
-            ++remainderPairs;
+            std::vector<typename matching_computer::EdgeWeightUpdate> updates;
+            for (const tournament::player_index opponentIndex : remainder)
+            {
+              const tournament::player_index opponentVertex = vertexIndices[opponentIndex];
+              tournament::player_index playerRemainderIndex{ };
+              for (const tournament::player_index playerIndex : remainder)
+              {
+                if (opponentIndex <= playerIndex)
+                {
+                  break;
+                }
+                updates.push_back({
+                  vertexIndices[playerIndex],
+                  opponentVertex,
+                  edgeWeightComputer(
+                    playerIndex,
+                    opponentIndex,
+                    playerRemainderIndex,
+                    remainderPairs)
+                });
+                ++playerRemainderIndex;
+              }
+            }
+            matchingComputer.setEdgeWeights(updates);
           }
-        }
-        /**
-         * An iterator to the first element in remainder that is in the lower
-         * group of players.
-         */
-        decltype(remainder)::const_iterator firstGroupEnd =
-          std::next(remainder.begin(), remainderPairs);
 
-        // Update edge weights to minimize exchanged players and the differences
-        // of exchanged BSNs.
-        for (const tournament::player_index opponentIndex : remainder)
-        {
-          const tournament::player_index opponentVertex = vertexIndices[opponentIndex];
-          tournament::player_index playerRemainderIndex{ };
+          matchingComputer.computeMatching(filterOuterOuterScans);
+          stableMatching = matchingComputer.getMatching();
+
+          /**
+           * The number of exchanges that must be made.
+           */
+          tournament::player_index exchangeCount{ };
           for (const tournament::player_index playerIndex : remainder)
           {
-            if (opponentIndex <= playerIndex)
+            if (playerIndex >= *firstGroupEnd)
             {
               break;
             }
-            matchingComputer.setEdgeWeight(
-              vertexIndices[playerIndex],
-              opponentVertex,
-              edgeWeightComputer(
-                playerIndex,
-                opponentIndex,
-                playerRemainderIndex,
-                remainderPairs));
-            ++playerRemainderIndex;
-          }
-        }
-
-        matchingComputer.computeMatching();
-        stableMatching = matchingComputer.getMatching();
-
-        /**
-         * The number of exchanges that must be made.
-         */
-        tournament::player_index exchangeCount{ };
-        for (const tournament::player_index playerIndex : remainder)
-        {
-          if (playerIndex >= *firstGroupEnd)
-          {
-            break;
+            const tournament::player_index playerVertex = vertexIndices[playerIndex];
+            exchangeCount +=
+              stableMatching[playerVertex] <= playerVertex
+                || stableMatching[playerVertex] >= nextScoreGroupBeginVertex;
           }
-          const tournament::player_index playerVertex = vertexIndices[playerIndex];
-          exchangeCount +=
-            stableMatching[playerVertex] <= playerVertex
-              || stableMatching[playerVertex] >= nextScoreGroupBeginVertex;
-        }
 
-        // Select lower players from the higher group to be exchanged where
-        // possible.
+          // Select lower players from the higher group to be exchanged where
+          // possible.
 
-        tournament::player_index exchangesRemaining = exchangeCount;
-        tournament::player_index playerRemainderIndex = remainderPairs;
-        for (
-          decltype(remainder)::const_iterator playerIterator = firstGroupEnd;
-          playerIterator != remainder.begin() && exchangesRemaining;
-        )
-        {
-          // Update edge weights to determine whether the current player can
-          // be exchanged.
-          decltype(remainder)::const_iterator opponentIterator = playerIterator;
-          --playerRemainderIndex;
-          --playerIterator;
-          const tournament::player_index playerVertex = vertexIndices[*playerIterator];
-          if (
-            stableMatching[playerVertex] > playerVertex
-              && stableMatching[playerVertex] < nextScoreGroupBeginVertex)
+          tournament::player_index exchangesRemaining = exchangeCount;
+          tournament::player_index playerRemainderIndex = remainderPairs;
+          for (
+            decltype(remainder)::const_iterator playerIterator = firstGroupEnd;
+            playerIterator != remainder.begin() && exchangesRemaining;
+          )
           {
-            while (opponentIterator != remainder.end())
+            // Update edge weights to determine whether the current player can
+            // be exchanged.
+            decltype(remainder)::const_iterator opponentIterator =
+              playerIterator;
+            --playerRemainderIndex;
+            --playerIterator;
+            const tournament::player_index playerVertex = vertexIndices[*playerIterator];
+            if (
+              stableMatching[playerVertex] > playerVertex
+                && stableMatching[playerVertex] < nextScoreGroupBeginVertex)
             {
-              matching_computer::edge_weight edgeWeight =
-                edgeWeightComputer(
-                  *playerIterator,
-                  *opponentIterator,
-                  playerRemainderIndex,
-                  remainderPairs);
-              if (edgeWeight)
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              while (opponentIterator != remainder.end())
               {
-                edgeWeight -= 1u;
-                matchingComputer.setEdgeWeight(
-                  playerVertex,
-                  vertexIndices[*opponentIterator],
-                  std::move(edgeWeight));
+                edge_weight edgeWeight =
+                  edgeWeightComputer(
+                    *playerIterator,
+                    *opponentIterator,
+                    playerRemainderIndex,
+                    remainderPairs);
+                if (edgeWeight)
+                {
+                  edgeWeight -= 1u;
+                  opponentVertices.push_back(vertexIndices[*opponentIterator]);
+                  edgeWeights.push_back(std::move(edgeWeight));
+                }
+                ++opponentIterator;
               }
-              ++opponentIterator;
-            }
+              matchingComputer.setEdgeWeights(
+                playerVertex,
+                opponentVertices,
+                edgeWeights);
 
-            matchingComputer.computeMatching();
+              matchingComputer.computeMatching(filterOuterOuterScans);
 
-            stableMatching = matchingComputer.getMatching();
-          }
+              stableMatching = matchingComputer.getMatching();
+            }
 
-          const bool exchange =
-            stableMatching[playerVertex] <= playerVertex
-              || stableMatching[playerVertex] >= nextScoreGroupBeginVertex;
+            const bool exchange =
+              stableMatching[playerVertex] <= playerVertex
+                || stableMatching[playerVertex] >= nextScoreGroupBeginVertex;
 
-          exchangesRemaining -= exchange;
+            exchangesRemaining -= exchange;
 
-          opponentIterator = std::next(playerIterator, 1);
-          while (opponentIterator != remainder.end())
-          {
-            // Finalize that this player must be exchanged, or restore the
-            // original edge weights.
-            if (exchange)
+            std::vector<tournament::player_index> opponentVertices;
+            std::vector<edge_weight> edgeWeights;
+            opponentIterator = std::next(playerIterator, 1);
+            while (opponentIterator != remainder.end())
             {
-              baseEdgeWeights[*opponentIterator][*playerIterator] &= 0u;
+              // Finalize that this player must be exchanged, or restore the
+              // original edge weights.
+              if (exchange)
+              {
+                baseEdgeWeights[*opponentIterator][*playerIterator] &= 0u;
+              }
+              opponentVertices.push_back(vertexIndices[*opponentIterator]);
+              edgeWeights.push_back(
+                edgeWeightComputer(
+                  *playerIterator,
+                  *opponentIterator,
+                  playerRemainderIndex,
+                  remainderPairs));
+              ++opponentIterator;
             }
-            matchingComputer.setEdgeWeight(
+            matchingComputer.setEdgeWeights(
               playerVertex,
-              vertexIndices[*opponentIterator],
-              edgeWeightComputer(
-                *playerIterator,
-                *opponentIterator,
-                playerRemainderIndex,
-                remainderPairs));
-            ++opponentIterator;
+              opponentVertices,
+              edgeWeights);
           }
-        }
 
-        // Select higher players from the lower group to be exchanged where
-        // possible.
+          // Select higher players from the lower group to be exchanged where
+          // possible.
 
-        exchangesRemaining = exchangeCount;
-        tournament::player_index remainderIndex = remainderPairs;
-        for (
-          decltype(remainder)::const_iterator playerIterator = firstGroupEnd;
-          playerIterator != remainder.end() && exchangesRemaining > 1u;
-          ++playerIterator)
-        {
-          const tournament::player_index playerVertex = vertexIndices[*playerIterator];
-          const bool alreadyExchanged =
-            stableMatching[playerVertex] > playerVertex
-              && stableMatching[playerVertex] < nextScoreGroupBeginVertex;
-          if (!alreadyExchanged)
+          exchangesRemaining = exchangeCount;
+          tournament::player_index remainderIndex = remainderPairs;
+          for (
+            decltype(remainder)::const_iterator playerIterator = firstGroupEnd;
+            playerIterator != remainder.end() && exchangesRemaining > 1u;
+            ++playerIterator)
           {
-            // Update edge weights to determine whether the current player
-            // can be exchanged.
-            for (
-              decltype(remainder)::const_iterator opponentIterator =
-                std::next(playerIterator, 1);
-              opponentIterator != remainder.end();
-              ++opponentIterator)
+            const tournament::player_index playerVertex = vertexIndices[*playerIterator];
+            const bool alreadyExchanged =
+              stableMatching[playerVertex] > playerVertex
+                && stableMatching[playerVertex] < nextScoreGroupBeginVertex;
+            if (!alreadyExchanged)
             {
-              matching_computer::edge_weight edgeWeight =
-                edgeWeightComputer(
-                  *playerIterator,
-                  *opponentIterator,
-                  remainderIndex,
-                  remainderPairs);
-              if (edgeWeight)
+              // Update edge weights to determine whether the current player
+              // can be exchanged.
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              for (
+                decltype(remainder)::const_iterator opponentIterator =
+                  std::next(playerIterator, 1);
+                opponentIterator != remainder.end();
+                ++opponentIterator)
               {
-                edgeWeight += 1u;
-                matchingComputer.setEdgeWeight(
-                  playerVertex,
-                  vertexIndices[*opponentIterator],
-                  std::move(edgeWeight));
+                edge_weight edgeWeight =
+                  edgeWeightComputer(
+                    *playerIterator,
+                    *opponentIterator,
+                    remainderIndex,
+                    remainderPairs);
+                if (edgeWeight)
+                {
+                  edgeWeight += 1u;
+                  opponentVertices.push_back(vertexIndices[*opponentIterator]);
+                  edgeWeights.push_back(std::move(edgeWeight));
+                }
               }
-            }
+              matchingComputer.setEdgeWeights(
+                playerVertex,
+                opponentVertices,
+                edgeWeights);
 
-            matchingComputer.computeMatching();
+              matchingComputer.computeMatching(filterOuterOuterScans);
 
-            stableMatching = matchingComputer.getMatching();
-          }
+              stableMatching = matchingComputer.getMatching();
+            }
 
-          const bool exchange =
-            stableMatching[playerVertex] > playerVertex
-              && stableMatching[playerVertex] < nextScoreGroupBeginVertex;
+            const bool exchange =
+              stableMatching[playerVertex] > playerVertex
+                && stableMatching[playerVertex] < nextScoreGroupBeginVertex;
 
-          if (exchange)
-          {
-            --exchangesRemaining;
+            if (exchange)
+            {
+              --exchangesRemaining;
 
-            // Finalize that this player must be exchanged.
+              // Finalize that this player must be exchanged.
 
-            for (
-              decltype(remainder)::const_iterator opponentIterator =
-                remainder.begin();
-              opponentIterator != playerIterator;
-              ++opponentIterator)
-            {
-              baseEdgeWeights[*playerIterator][*opponentIterator] &= 0u;
-              matchingComputer.setEdgeWeight(
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              for (
+                decltype(remainder)::const_iterator opponentIterator =
+                  remainder.begin();
+                opponentIterator != playerIterator;
+                ++opponentIterator)
+              {
+                baseEdgeWeights[*playerIterator][*opponentIterator] &= 0u;
+                opponentVertices.push_back(vertexIndices[*opponentIterator]);
+                edgeWeights.push_back(
+                  baseEdgeWeights[*playerIterator][*opponentIterator]);
+              }
+
+              for (
+                tournament::player_index opponentIndex = nextScoreGroupBegin;
+                opponentIndex < playersByIndex.size();
+                ++opponentIndex)
+              {
+                baseEdgeWeights[opponentIndex][*playerIterator] &= 0u;
+                opponentVertices.push_back(vertexIndices[opponentIndex]);
+                edgeWeights.push_back(
+                  baseEdgeWeights[opponentIndex][*playerIterator]);
+              }
+              matchingComputer.setEdgeWeights(
                 playerVertex,
-                vertexIndices[*opponentIterator],
-                baseEdgeWeights[*playerIterator][*opponentIterator]);
+                opponentVertices,
+                edgeWeights);
             }
-
-            for (
-              tournament::player_index opponentIndex = nextScoreGroupBegin;
-              opponentIndex < playersByIndex.size();
-              ++opponentIndex)
+            if (!alreadyExchanged)
             {
-              baseEdgeWeights[opponentIndex][*playerIterator] &= 0u;
-              matchingComputer.setEdgeWeight(
+              // Restore the original edge weights.
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              for (
+                decltype(remainder)::const_iterator opponentIterator =
+                  std::next(playerIterator, 1);
+                opponentIterator != remainder.end();
+                ++opponentIterator)
+              {
+                opponentVertices.push_back(vertexIndices[*opponentIterator]);
+                edgeWeights.push_back(
+                  edgeWeightComputer(
+                    *playerIterator,
+                    *opponentIterator,
+                    remainderIndex,
+                    remainderPairs));
+              }
+              matchingComputer.setEdgeWeights(
                 playerVertex,
-                vertexIndices[opponentIndex],
-                baseEdgeWeights[opponentIndex][*playerIterator]);
+                opponentVertices,
+                edgeWeights);
             }
+            ++remainderIndex;
           }
-          if (!alreadyExchanged)
+
+          // Finalize which players will be exchanged, and reset the bits we
+          // used for determining that.
+          remainderIndex = 0;
           {
-            // Restore the original edge weights.
+            std::vector<typename matching_computer::EdgeWeightUpdate> updates;
             for (
-              decltype(remainder)::const_iterator opponentIterator =
-                std::next(playerIterator, 1);
-              opponentIterator != remainder.end();
-              ++opponentIterator)
+              decltype(remainder)::const_iterator playerIterator =
+                remainder.begin();
+              playerIterator != remainder.end();
+              ++playerIterator)
             {
-              matchingComputer.setEdgeWeight(
-                playerVertex,
-                vertexIndices[*opponentIterator],
-                edgeWeightComputer(
-                  *playerIterator,
-                  *opponentIterator,
-                  remainderIndex,
-                  remainderPairs));
+              const tournament::player_index playerVertex = vertexIndices[*playerIterator];
+              for (
+                decltype(remainder)::const_iterator opponentIterator =
+                  std::next(playerIterator, 1);
+                opponentIterator != remainder.end();
+                ++opponentIterator)
+              {
+                const tournament::player_index opponentVertex =
+                  vertexIndices[*opponentIterator];
+                if (
+                  stableMatching[playerVertex] <= playerVertex
+                    || stableMatching[playerVertex] >= nextScoreGroupBeginVertex
+                    || (stableMatching[opponentVertex] > opponentVertex
+                          && stableMatching[opponentVertex] < nextScoreGroupBeginVertex
+                        )
+                )
+                {
+                  baseEdgeWeights[*opponentIterator][*playerIterator] &= 0u;
+                }
+                updates.push_back({
+                  playerVertex,
+                  opponentVertex,
+                  baseEdgeWeights[*opponentIterator][*playerIterator]
+                });
+              }
+              ++remainderIndex;
             }
+            matchingComputer.setEdgeWeights(updates);
           }
-          ++remainderIndex;
-        }
 
-        // Finalize which players will be exchanged, and reset the bits we used
-        // for determining that.
-        remainderIndex = 0;
-        for (
-          decltype(remainder)::const_iterator playerIterator =
-            remainder.begin();
-          playerIterator != remainder.end();
-          ++playerIterator)
-        {
-          const tournament::player_index playerVertex = vertexIndices[*playerIterator];
-          for (
-            decltype(remainder)::const_iterator opponentIterator =
-              std::next(playerIterator, 1);
-            opponentIterator != remainder.end();
-            ++opponentIterator)
+          // Choose the players to be paired with each of the players in the
+          // first group.
+          remainderIndex = 0;
+          for (const tournament::player_index playerIndex : remainder)
           {
-            const tournament::player_index opponentVertex =
-              vertexIndices[*opponentIterator];
+            const tournament::player_index playerVertex = vertexIndices[playerIndex];
             if (
-              stableMatching[playerVertex] <= playerVertex
-                || stableMatching[playerVertex] >= nextScoreGroupBeginVertex
-                || (stableMatching[opponentVertex] > opponentVertex
-                      && stableMatching[opponentVertex] < nextScoreGroupBeginVertex
-                    )
-            )
+              stableMatching[playerVertex] > playerVertex
+                && stableMatching[playerVertex] < nextScoreGroupBeginVertex)
             {
-              baseEdgeWeights[*opponentIterator][*playerIterator] &= 0u;
+              // Set edge weights to prioritize higher players.
+              tournament::player_index addend{ };
+              std::vector<tournament::player_index> opponentVertices;
+              std::vector<edge_weight> edgeWeights;
+              for (
+                decltype(remainder)::const_reverse_iterator opponentIterator =
+                  remainder.rbegin();
+                opponentIterator != remainder.rend();
+                ++opponentIterator)
+              {
+                const tournament::player_index opponentVertex =
+                  vertexIndices[*opponentIterator];
+                if (
+                  *opponentIterator <= playerIndex || matched[opponentVertex])
+                {
+                  continue;
+                }
+                edge_weight edgeWeight =
+                  baseEdgeWeights[*opponentIterator][playerIndex];
+                if (edgeWeight)
+                {
+                  edgeWeight += addend;
+                  opponentVertices.push_back(opponentVertex);
+                  edgeWeights.push_back(std::move(edgeWeight));
+                }
+                ++addend;
+              }
+              matchingComputer.setEdgeWeights(
+                playerVertex,
+                opponentVertices,
+                edgeWeights);
+
+              matchingComputer.computeMatching(filterOuterOuterScans);
+
+              stableMatching = matchingComputer.getMatching();
+
+              // Finalize the pairing.
+              const tournament::player_index matchVertex =
+                stableMatching[playerVertex];
+              matched[playerVertex] = true;
+              matched[matchVertex] = true;
+              finalizePair(
+                playerVertex,
+                matchVertex,
+                matchingComputer,
+                maxEdgeWeight);
             }
-            matchingComputer.setEdgeWeight(
-              playerVertex,
-              opponentVertex,
-              baseEdgeWeights[*opponentIterator][*playerIterator]);
+            ++remainderIndex;
           }
-          ++remainderIndex;
-        }
 
-        // Choose the players to be paired with each of the players in the first
-        // group.
-        remainderIndex = 0;
-        for (const tournament::player_index playerIndex : remainder)
-        {
-          const tournament::player_index playerVertex = vertexIndices[playerIndex];
-          if (
-            stableMatching[playerVertex] > playerVertex
-              && stableMatching[playerVertex] < nextScoreGroupBeginVertex)
+          // Compute the new values for the next pairing bracket.
+          std::vector<const tournament::Player *> newPlayersByIndex;
+          std::vector<tournament::player_index> newVertexIndices;
+          scoreGroupBegin = 0;
+
+          // Preliminary (may be set to false in the subsequent loop)
+          isSingleDownfloaterTheByeAssignee =
+            sortedPlayers.size() & 1u
+              && scoreGroupIterator != sortedPlayers.end()
+              && byeAssigneeScore
+                  >= (*scoreGroupIterator)->scoreWithAcceleration(tournament);
+
+          for (
+            tournament::player_index playerIndex = 0;
+            playerIndex < playersByIndex.size();
+            ++playerIndex)
           {
-            // Set edge weights to prioritize higher players.
-            tournament::player_index addend{ };
-            for (
-              decltype(remainder)::const_reverse_iterator opponentIterator =
-                remainder.rbegin();
-              opponentIterator != remainder.rend();
-              ++opponentIterator)
+            const tournament::player_index playerVertex = vertexIndices[playerIndex];
+            if (playerIndex < nextScoreGroupBegin && matched[playerVertex])
             {
-              const tournament::player_index opponentVertex =
-                vertexIndices[*opponentIterator];
-              if (
-                *opponentIterator <= playerIndex || matched[opponentVertex])
+              // Save the pair in matchingById.
+              matchingById[playersByIndex[playerIndex]->id] =
+                playersByVertex[stableMatching[playerVertex]];
+              matchingById[playersByVertex[stableMatching[playerVertex]]->id] =
+                playersByIndex[playerIndex];
+            }
+            else
+            {
+              // Add the player to the next bracket.
+              newPlayersByIndex.push_back(playersByIndex[playerIndex]);
+              newVertexIndices.push_back(vertexIndices[playerIndex]);
+              if (playerIndex < nextScoreGroupBegin)
               {
-                continue;
+                ++scoreGroupBegin;
               }
-              matching_computer::edge_weight edgeWeight =
-                baseEdgeWeights[*opponentIterator][playerIndex];
-              if (edgeWeight)
+              if (
+                isSingleDownfloaterTheByeAssignee
+                  && playersByVertex[stableMatching[playerVertex]]
+                        ->scoreWithAcceleration(tournament)
+                      < (*scoreGroupIterator)
+                          ->scoreWithAcceleration(tournament))
               {
-                edgeWeight += addend;
-                matchingComputer.setEdgeWeight(
-                  playerVertex,
-                  opponentVertex,
-                  std::move(edgeWeight));
+                isSingleDownfloaterTheByeAssignee = false;
               }
-              ++addend;
             }
+          }
 
-            matchingComputer.computeMatching();
-
-            stableMatching = matchingComputer.getMatching();
-
-            // Finalize the pairing.
-            const tournament::player_index matchVertex =
-              stableMatching[playerVertex];
-            matched[playerVertex] = true;
-            matched[matchVertex] = true;
-            finalizePair(
-              playerVertex,
-              matchVertex,
+          playersByIndex = std::move(newPlayersByIndex);
+          vertexIndices = std::move(newVertexIndices);
+          scoreGroupBeginVertex = nextScoreGroupBeginVertex;
+
+#ifdef DUTCH_BRACKET_LOCAL
+          // Solve the later brackets on a smaller graph once at least half
+          // of the vertices are in finalized pairs.
+          const tournament::player_index remainingVertices =
+            scoreGroupBegin
+              + (matchingComputer.size() - scoreGroupBeginVertex);
+          if (remainingVertices <= matchingComputer.size() - remainingVertices)
+          {
+            compactMatchingComputer(
               matchingComputer,
-              maxEdgeWeight);
+              maxEdgeWeight,
+              playersByVertex,
+              matched,
+              vertexIndices,
+              scoreGroupBeginVertex,
+              retiredStats);
           }
-          ++remainderIndex;
+#endif
         }
 
-        // Compute the new values for the next pairing bracket.
-        std::vector<const tournament::Player *> newPlayersByIndex;
-        std::vector<tournament::player_index> newVertexIndices;
-        scoreGroupBegin = 0;
-
-        // Preliminary (may be set to false in the subsequent loop)
-        isSingleDownfloaterTheByeAssignee =
-          sortedPlayers.size() & 1u
-            && scoreGroupIterator != sortedPlayers.end()
-            && byeAssigneeScore
-                >= (*scoreGroupIterator)->scoreWithAcceleration(tournament);
-
-        for (
-          tournament::player_index playerIndex = 0;
-          playerIndex < playersByIndex.size();
-          ++playerIndex)
+        // Generate the list of Pairings.
+        std::list<Pairing> result;
+        for (const tournament::Player *const player : sortedPlayers)
         {
-          const tournament::player_index playerVertex = vertexIndices[playerIndex];
-          if (playerIndex < nextScoreGroupBegin && matched[playerVertex])
+          const tournament::Player *const match = matchingById[player->id];
+          if (match)
           {
-            // Save the pair in matchingById.
-            matchingById[playersByIndex[playerIndex]->id] =
-              sortedPlayers[stableMatching[playerVertex]];
-            matchingById[sortedPlayers[stableMatching[playerVertex]]->id] =
-              playersByIndex[playerIndex];
+            assert(player->isValid);
+            assert(
+              tournament.matchHistory.getMatchCount(player->id)
+                <= tournament.playedRounds);
+            assert(match->isValid);
+            assert(
+              tournament.matchHistory.getMatchCount(match->id)
+                <= tournament.playedRounds);
+            if (player->id < match->id)
+            {
+              result.emplace_back(
+                player->id,
+                match->id,
+                choosePlayerColor(
+                  tournament.players[player->id],
+                  *match,
+                  tournament));
+            }
           }
           else
           {
-            // Add the player to the next bracket.
-            newPlayersByIndex.push_back(playersByIndex[playerIndex]);
-            newVertexIndices.push_back(vertexIndices[playerIndex]);
-            if (playerIndex < nextScoreGroupBegin)
-            {
-              ++scoreGroupBegin;
-            }
-            if (
-              isSingleDownfloaterTheByeAssignee
-                && sortedPlayers[stableMatching[playerVertex]]
-                      ->scoreWithAcceleration(tournament)
-                    < (*scoreGroupIterator)->scoreWithAcceleration(tournament))
-            {
-              isSingleDownfloaterTheByeAssignee = false;
-            }
+            result.emplace_back(player->id, player->id);
           }
         }
 
-        playersByIndex = std::move(newPlayersByIndex);
-        vertexIndices = std::move(newVertexIndices);
-        scoreGroupBeginVertex = nextScoreGroupBeginVertex;
+        // Print the checklist, followed by the matching statistics if they
+        // are gathered.
+        if (ostream)
+        {
+          printChecklist(tournament, sortedPlayers, *ostream, &matchingById);
+#ifdef MATCHING_STATS
+          *ostream << (retiredStats += matchingComputer.getStats());
+#endif
+        }
+
+        return result;
       }
+    }
 
-      // Generate the list of Pairings.
-      std::list<Pairing> result;
-      for (const tournament::Player *const player : sortedPlayers)
+    /**
+     * Compute the matching, and return the list of Pairings in arbitrary order.
+     * If no matching is possible, throw a NoValidPairingException.
+     * This runs in theoretic time O(n^3 * s^2 * log n), where n is the
+     * number of players and s is the number of occupied score groups.
+     */
+    std::list<Pairing> computeMatching(
+      const tournament::Tournament &tournament,
+      std::ostream *const ostream)
+    {
+      // Filter out the absent players, and sort the remainder by score and
+      // pairing ID.
+      std::vector<const tournament::Player *> sortedPlayers;
+      // We add forbidden pairs due to previous matches below
+      auto forbiddenPairs = tournament.resolveForbiddenPairs(tournament.playedRounds);
+      for (const tournament::Player &player : tournament.players)
       {
-        const tournament::Player *const match = matchingById[player->id];
-        if (match)
+        if (
+          player.isValid
+            && tournament.matchHistory.getMatchCount(player.id)
+                <= tournament.playedRounds)
         {
-          assert(player->isValid);
-          assert(player->matches.size() <= tournament.playedRounds);
-          assert(match->isValid);
-          assert(match->matches.size() <= tournament.playedRounds);
-          if (player->id < match->id)
+          sortedPlayers.push_back(&player);
+        }
+      }
+      const tournament::MatchHistory &matchHistory = tournament.matchHistory;
+      for (
+        tournament::round_index round{ };
+        round < matchHistory.getRoundCount();
+        ++round)
+      {
+        for (
+          tournament::player_index playerIndex{ };
+          playerIndex < matchHistory.getPlayerCount();
+          ++playerIndex)
+        {
+          if (
+            tournament.players[playerIndex].isValid
+              && matchHistory.getGameWasPlayed(round, playerIndex))
           {
-            result.emplace_back(
-              player->id,
-              match->id,
-              choosePlayerColor(
-                tournament.players[player->id],
-                *match,
-                tournament));
+            forbiddenPairs.set(
+              playerIndex,
+              matchHistory.getOpponent(round, playerIndex));
           }
         }
-        else
+      }
+      std::sort(
+        sortedPlayers.begin(),
+        sortedPlayers.end(),
+        [&tournament](
+          const tournament::Player *const player0,
+          const tournament::Player *const player1)
+        {
+          return
+            tournament
+              ::acceleratedScoreRankCompare(player1, player0, tournament);
+        }
+      );
+
+      // Calculate the number of bits needed to prioritize moved-down players.
+      score_group_shift scoreGroupsShift{ };
+      std::unordered_map<tournament::points, score_group_shift>
+        scoreGroupShifts{ };
+      tournament::player_index maxScoreGroupSize{ };
+      tournament::player_index repeatedScores{ };
+      for (
+        auto nextIterator = sortedPlayers.rbegin();
+        nextIterator != sortedPlayers.rend();
+      )
+      {
+        const auto currentIterator = nextIterator++;
+        ++repeatedScores;
+        const tournament::points currentScore =
+          (*currentIterator)->scoreWithAcceleration(tournament);
+        if (
+          nextIterator == sortedPlayers.rend()
+            || currentScore < (*nextIterator)->scoreWithAcceleration(tournament)
+        )
         {
-          result.emplace_back(player->id, player->id);
+          const unsigned int newBits =
+            utility::typesizes::bitsToRepresent<unsigned int>(repeatedScores);
+          scoreGroupShifts[currentScore] = scoreGroupsShift;
+          maxScoreGroupSize = std::max(maxScoreGroupSize, repeatedScores);
+          repeatedScores = 0;
+          scoreGroupsShift += newBits;
+          assert(scoreGroupsShift >= newBits);
         }
       }
 
-      // Print the checklist.
+      const unsigned int scoreGroupSizeBits =
+        utility::typesizes::bitsToRepresent<unsigned int>(maxScoreGroupSize);
+
+      std::unordered_map<tournament::round_index, tournament::player_index>
+        unplayedGameRanks{ };
+
+      // Compute an edge weight upper bound, growing it to the number of pieces
+      // needed to represent the edge weights.
+      const PairingCriteria criteria(sortedPlayers, tournament, forbiddenPairs);
+
+      utility::uinttypes::DynamicUint maxEdgeWeight{ 0u };
+      computeEdgeWeight<true>(
+        *sortedPlayers.front(),
+        *sortedPlayers.front(),
+        true,
+        false,
+        0u,
+        tournament,
+        criteria,
+        scoreGroupSizeBits,
+        scoreGroupsShift,
+        scoreGroupShifts,
+        false,
+        unplayedGameRanks,
+        maxEdgeWeight);
+#ifdef MATCHING_STATS
       if (ostream)
       {
-        printChecklist(tournament, sortedPlayers, *ostream, &matchingById);
+        unsigned int edgeWeightBits{ };
+        for (
+          utility::uinttypes::DynamicUint remainder{ maxEdgeWeight };
+          remainder;
+          remainder >>= 1u)
+        {
+          ++edgeWeightBits;
+        }
+        *ostream << "edge weight width=" << edgeWeightBits << "b\n";
       }
+#endif
 
-      return result;
+      // Run the matching computer on the narrowest type that can hold the
+      // edge weights, so that typical tournaments avoid the overhead of
+      // DynamicUint arithmetic.
+      const auto pairPlayers =
+        [&](const auto &typedMaxEdgeWeight)
+        {
+          return
+            pairSortedPlayers(
+              tournament,
+              ostream,
+              sortedPlayers,
+              criteria,
+              scoreGroupSizeBits,
+              scoreGroupsShift,
+              scoreGroupShifts,
+              std::move(unplayedGameRanks),
+              typedMaxEdgeWeight);
+        };
+      const utility::uinttypes::DynamicUint::const_view maxEdgeWeightView{
+        maxEdgeWeight
+      };
+      switch (
+        std::distance(maxEdgeWeightView.begin(), maxEdgeWeightView.end()))
+      {
+      case 1:
+        return pairPlayers(toFixedWidth<1>(maxEdgeWeight));
+      case 2:
+        return pairPlayers(toFixedWidth<2>(maxEdgeWeight));
+      case 3:
+        return pairPlayers(toFixedWidth<3>(maxEdgeWeight));
+      case 4:
+        return pairPlayers(toFixedWidth<4>(maxEdgeWeight));
+      default:
+        return pairPlayers(maxEdgeWeight);
+      }
     }
   }
 }
@@ -1,11 +1,13 @@
 #ifndef DUTCH_H
 #define DUTCH_H
 
+#include <cstddef>
 #include <list>
 #include <utility>
 
 #include <matching/computer.h>
 #include <utility/dynamicuint.h>
+#include <utility/uint.h>
 
 #include "common.h"
 
@@ -19,21 +21,41 @@ namespace swisssystems
 {
   namespace dutch
   {
+    /**
+     * The matching computer used when the edge weights are too wide to be
+     * stored in a fixed-width type.
+     */
     typedef matching::Computer<utility::uinttypes::DynamicUint>
       matching_computer;
 
+    /**
+     * The largest number of std::uintmax_t pieces for which the edge weights
+     * are stored in a utility::uinttypes::uint instead of a DynamicUint. Each
+     * width up to this value needs a matching::Computer instantiation in
+     * templateinstantiation.h.
+     */
+    constexpr std::size_t maxFixedWidthEdgeWeightPieces = 4u;
+
+    /**
+     * The matching computer used when the edge weights fit in the specified
+     * number of std::uintmax_t pieces.
+     */
+    template <std::size_t pieces>
+    using fixed_width_matching_computer =
+      matching::Computer<utility::uinttypes::uint<pieces>>;
+
     std::list<Pairing> computeMatching(
-      tournament::Tournament &&,
+      const tournament::Tournament &,
       std::ostream *const = nullptr);
 
     struct DutchInfo final : public Info
     {
       std::list<Pairing> computeMatching(
-        tournament::Tournament &&tournament,
+        const tournament::Tournament &tournament,
         std::ostream *const ostream
       ) const override
       {
-        return dutch::computeMatching(std::move(tournament), ostream);
+        return dutch::computeMatching(tournament, ostream);
       }
     };
   }
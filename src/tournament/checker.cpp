@@ -28,10 +28,13 @@ namespace tournament
       const swisssystems::Info &info = swisssystems::getInfo(swissSystem);
       Tournament tournament = originalTournament;
 
-      for (Player &player : tournament.players)
+      for (
+        player_index playerIndex{ };
+        playerIndex < tournament.players.size();
+        ++playerIndex)
       {
-        player.matches.clear();
-        player.scoreWithoutAcceleration = 0;
+        tournament.matchHistory.clear(playerIndex);
+        tournament.players[playerIndex].scoreWithoutAcceleration = 0;
       }
 
       // Iterate over the rounds.
@@ -43,15 +46,13 @@ namespace tournament
         // Add byes.
         for (const player_index playerIndex : tournament.playersByRank)
         {
-          Player &player = tournament.players[playerIndex];
-          const Match &originalMatch =
-            originalTournament.players
+          const Match originalMatch =
+            originalTournament.matchHistory
               [playerIndex]
-              .matches
               [tournament.playedRounds];
           if (!originalMatch.participatedInPairing)
           {
-            player.matches.push_back(originalMatch);
+            tournament.matchHistory.push_back(playerIndex, originalMatch);
           }
         }
 
@@ -81,9 +82,7 @@ namespace tournament
         try
         {
           correctMatching =
-            info.computeMatching(
-              Tournament(tournament),
-              checklistStream);
+            info.computeMatching(tournament, checklistStream);
 
           // Find the incorrect pairings.
           std::list<swisssystems::Pairing> providedMatching;
@@ -95,10 +94,9 @@ namespace tournament
             iterator = nextIterator)
           {
             ++nextIterator;
-            const Match &whiteMatch =
-              originalTournament.players
+            const Match whiteMatch =
+              originalTournament.matchHistory
                 [iterator->white]
-                .matches
                 [tournament.playedRounds];
 
             if (
@@ -109,10 +107,9 @@ namespace tournament
             }
             else
             {
-              const Match &blackMatch =
-                originalTournament.players
+              const Match blackMatch =
+                originalTournament.matchHistory
                   [iterator->black]
-                  .matches
                   [tournament.playedRounds];
 
               if (iterator->white <= whiteMatch.opponent)
@@ -206,14 +203,13 @@ namespace tournament
         for (const player_index playerIndex : tournament.playersByRank)
         {
           Player &player = tournament.players[playerIndex];
-          const Match &match =
-            originalTournament.players
+          const Match match =
+            originalTournament.matchHistory
               [playerIndex]
-              .matches
               [tournament.playedRounds];
           if (match.participatedInPairing)
           {
-            player.matches.push_back(match);
+            tournament.matchHistory.push_back(playerIndex, match);
           }
           player.scoreWithoutAcceleration +=
             tournament.getPoints(player, match);
@@ -117,7 +117,7 @@ namespace tournament
         bool zeroPointBye{ };
         bool halfPointBye{ };
 
-        for (const Match &match : player.matches)
+        for (const Match &match : tournament.matchHistory[playerIndex])
         {
           if (match.participatedInPairing && match.opponent != player.id)
           {
@@ -179,7 +179,7 @@ namespace tournament
           assert(halfPointByePlayers);
         }
 
-        player.matches.clear();
+        tournament.matchHistory.clear(playerIndex);
         player.scoreWithoutAcceleration = 0;
       }
 
@@ -431,12 +431,9 @@ namespace tournament
                       - 2u
                   ) < halfPointByeCounts[rankIndex])
           {
-            player.matches.emplace_back(
-              player.id,
-              COLOR_NONE,
-              MATCH_SCORE_DRAW,
-              false,
-              false);
+            result.matchHistory.push_back(
+              playerIndex,
+              Match(player.id, COLOR_NONE, MATCH_SCORE_DRAW, false, false));
             --halfPointByeCounts[rankIndex];
           }
           else if (
@@ -450,12 +447,9 @@ namespace tournament
             ) < zeroPointByeCounts[rankIndex]
           )
           {
-            player.matches.emplace_back(
-              player.id,
-              COLOR_NONE,
-              MATCH_SCORE_LOSS,
-              false,
-              false);
+            result.matchHistory.push_back(
+              playerIndex,
+              Match(player.id, COLOR_NONE, MATCH_SCORE_LOSS, false, false));
             --zeroPointByeCounts[rankIndex];
           }
           ++rankIndex;
@@ -485,7 +479,7 @@ namespace tournament
         {
           matching =
             swisssystems::getInfo(swissSystem).computeMatching(
-              Tournament(result),
+              result,
               checklistStream);
         }
         catch (const swisssystems::NoValidPairingException &exception)
@@ -504,20 +498,17 @@ namespace tournament
         {
           assert(
             result.players[pair.white].isValid
-              && result.players[pair.white].matches.size()
+              && result.matchHistory.getMatchCount(pair.white)
                   <= result.playedRounds);
           assert(
             result.players[pair.black].isValid
-              && result.players[pair.black].matches.size()
+              && result.matchHistory.getMatchCount(pair.black)
                   <= result.playedRounds);
           if (pair.white == pair.black)
           {
-            result.players[pair.white].matches.emplace_back(
+            result.matchHistory.push_back(
               pair.white,
-              COLOR_NONE,
-              MATCH_SCORE_WIN,
-              false,
-              true);
+              Match(pair.white, COLOR_NONE, MATCH_SCORE_WIN, false, true));
           }
           else
           {
@@ -575,18 +566,12 @@ namespace tournament
               }
               resultForBlack = invert(resultForWhite);
             }
-            result.players[pair.white].matches.emplace_back(
-              pair.black,
-              COLOR_WHITE,
-              resultForWhite,
-              !forfeit,
-              true);
-            result.players[pair.black].matches.emplace_back(
+            result.matchHistory.push_back(
               pair.white,
-              COLOR_BLACK,
-              resultForBlack,
-              !forfeit,
-              true);
+              Match(pair.black, COLOR_WHITE, resultForWhite, !forfeit, true));
+            result.matchHistory.push_back(
+              pair.black,
+              Match(pair.white, COLOR_BLACK, resultForBlack, !forfeit, true));
           }
         }
 
@@ -596,7 +581,7 @@ namespace tournament
           Player &player = result.players[playerIndex];
 
           const points newPoints =
-            result.getPoints(player, player.matches.back());
+            result.getPoints(player, result.matchHistory[playerIndex].back());
           player.scoreWithoutAcceleration += newPoints;
           if (player.scoreWithoutAcceleration < newPoints)
           {
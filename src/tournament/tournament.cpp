@@ -1,4 +1,8 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <vector>
 
 #include <utility/uintstringconversion.h>
 
@@ -6,26 +10,138 @@
 
 namespace tournament
 {
+  /**
+   * Append the match to the matches of the player, adding a round for all the
+   * players if the player has a match on every stored round.
+   */
+  void MatchHistory::push_back(const player_index player, const Match &match) &
+  {
+    addPlayer(player);
+    if (matchCounts[player] >= roundCount)
+    {
+      opponents.resize(opponents.size() + playerCapacity);
+      flags.resize(flags.size() + playerCapacity);
+      ++roundCount;
+      for (player_index index{ }; index < getPlayerCount(); ++index)
+      {
+        set(roundCount - 1u, index, Match(index));
+      }
+    }
+    set(matchCounts[player]++, player, match);
+  }
+
+  /**
+   * Truncate the matches of the player to matchCount, or pad them with
+   * absences up to matchCount.
+   */
+  void MatchHistory::resize(
+    const player_index player,
+    const round_index matchCount
+  ) &
+  {
+    addPlayer(player);
+    while (matchCounts[player] < matchCount)
+    {
+      push_back(player, Match(player));
+    }
+    for (round_index round = matchCount; round < matchCounts[player]; ++round)
+    {
+      set(round, player, Match(player));
+    }
+    matchCounts[player] = matchCount;
+  }
+
+  void MatchHistory::set(
+    const round_index round,
+    const player_index player,
+    const Match &match
+  ) &
+  {
+    const std::size_t index = round * playerCapacity + player;
+    opponents[index] = match.opponent;
+    flags[index] =
+      std::uint_least8_t(
+        match.color
+          | match.matchScore << matchScoreShift
+          | match.gameWasPlayed << gameWasPlayedShift
+          | match.participatedInPairing << participatedShift);
+  }
+
+  /**
+   * Give the player and those before it a column of absences, moving the
+   * rounds apart if they have no room for it.
+   */
+  void MatchHistory::addPlayer(const player_index player) &
+  {
+    if (player < matchCounts.size())
+    {
+      return;
+    }
+    if (player >= playerCapacity)
+    {
+      const std::size_t newCapacity =
+        std::max<std::size_t>(player + 1u, playerCapacity * 2u);
+      std::vector<player_index> newOpponents(roundCount * newCapacity);
+      std::vector<std::uint_least8_t> newFlags(roundCount * newCapacity);
+      for (round_index round{ }; round < roundCount; ++round)
+      {
+        std::copy(
+          opponents.data() + round * playerCapacity,
+          opponents.data() + round * playerCapacity + matchCounts.size(),
+          newOpponents.data() + round * newCapacity);
+        std::copy(
+          flags.data() + round * playerCapacity,
+          flags.data() + round * playerCapacity + matchCounts.size(),
+          newFlags.data() + round * newCapacity);
+      }
+      opponents.swap(newOpponents);
+      flags.swap(newFlags);
+      playerCapacity = newCapacity;
+    }
+    const player_index firstNewPlayer = getPlayerCount();
+    matchCounts.resize(player + 1u);
+    for (round_index round{ }; round < roundCount; ++round)
+    {
+      for (
+        player_index index = firstNewPlayer;
+        index < getPlayerCount();
+        ++index)
+      {
+        set(round, index, Match(index));
+      }
+    }
+  }
+
   /**
    * Update players' rankIndex and isValid members. Check that the maximum
    * number of players has not been exceeded.
    */
   void Tournament::updateRanks() &
   {
-    player_index effectivePairingNumber{ };
+    // Update isValid.
     for (const player_index playerIndex : playersByRank)
     {
-      Player &player = players[playerIndex];
-
-      // Update isValid.
-      player.isValid = player.matches.size() <= playedRounds;
-      for (const Match &match : player.matches)
+      players[playerIndex].isValid =
+        matchHistory.getMatchCount(playerIndex) <= playedRounds;
+    }
+    for (round_index round{ }; round < matchHistory.getRoundCount(); ++round)
+    {
+      for (
+        player_index playerIndex{ };
+        playerIndex < matchHistory.getPlayerCount();
+        ++playerIndex)
       {
-        if (match.participatedInPairing)
+        if (matchHistory.getParticipatedInPairing(round, playerIndex))
         {
-          player.isValid = true;
+          players[playerIndex].isValid = true;
         }
       }
+    }
+
+    player_index effectivePairingNumber{ };
+    for (const player_index playerIndex : playersByRank)
+    {
+      Player &player = players[playerIndex];
 
       if (player.isValid)
       {
@@ -51,7 +167,7 @@ namespace tournament
         round_index gamesAsBlack{ };
         player_index consecutiveCount{ };
         round_index playedGames{ };
-        for (const Match &match : player.matches)
+        for (const Match &match : matchHistory[player.id])
         {
           if (match.gameWasPlayed)
           {
@@ -89,6 +205,18 @@ namespace tournament
         }
         player.strongColorPreference =
           !player.absoluteColorPreference() && player.colorImbalance;
+
+        // Record the score before each round, working back from the current
+        // score.
+        points score = player.scoreWithoutAcceleration;
+        player.scoreHistory.resize(playedRounds + 1u);
+        player.scoreHistory[playedRounds] = score;
+        for (round_index roundIndex = playedRounds; roundIndex > 0u; )
+        {
+          --roundIndex;
+          score -= getPoints(player, matchHistory[player.id][roundIndex]);
+          player.scoreHistory[roundIndex] = score;
+        }
       }
     }
   }
@@ -96,10 +224,10 @@ namespace tournament
   /**
     * Exclude any players in forbidden from playing each other.
     */
-  std::vector<std::unordered_set<player_index>>
+  utility::bitmatrix::BitMatrix
     Tournament::resolveForbiddenPairs(round_index roundIndex) const &
   {
-    std::vector<std::unordered_set<player_index>> result(players.size());
+    utility::bitmatrix::BitMatrix result(players.size());
     for (const auto &entry : forbiddenPairs)
     {
       if (roundIndex < entry.roundStart || roundIndex >= entry.roundEnd)
@@ -109,7 +237,10 @@ namespace tournament
 
       for (const auto player1Index : entry.players)
       {
-        result[player1Index].insert(entry.players.begin(), entry.players.end());
+        for (const auto player2Index : entry.players)
+        {
+          result.set(player1Index, player2Index);
+        }
       }
     }
 
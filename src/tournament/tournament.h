@@ -1,15 +1,19 @@
 #ifndef TOURNAMENT_H
 #define TOURNAMENT_H
 
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <iterator>
 #include <limits>
 #include <stdexcept>
 #include <string>
 #include <tuple>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include <utility/bitmatrix.h>
 #include <utility/typesizes.h>
 #include <utility/uintstringconversion.h>
 #include <utility/uinttypes.h>
@@ -152,14 +156,13 @@ namespace tournament
 
   struct Player
   {
-    matches_vector matches;
     /**
      * Round-indexed accelerations. If the vector is shorter than the number of
      * rounds, zeroes are implied.
      */
     std::vector<points> accelerations;
 
-    decltype(matches)::size_type colorImbalance{ };
+    matches_vector::size_type colorImbalance{ };
 
     /**
      * The zero-indexed pairing ID used for input/output.
@@ -179,6 +182,11 @@ namespace tournament
     round_index playedGames{ };
 
     points scoreWithoutAcceleration;
+    /**
+     * Round-indexed scores without acceleration, from before the first round
+     * up to the current one, computed by Tournament::computePlayerData.
+     */
+    std::vector<points> scoreHistory;
 
     Color colorPreference = COLOR_NONE;
     Color repeatedColor = COLOR_NONE;
@@ -194,10 +202,8 @@ namespace tournament
     Player(
         const player_index id_,
         const points points_,
-        const tournament::rating rating_,
-        std::vector<Match> &&matches_ = std::vector<Match>())
-      : matches(std::move(matches_)),
-        id(id_),
+        const tournament::rating rating_)
+      : id(id_),
         rankIndex(id_),
         rating(rating_),
         scoreWithoutAcceleration(points_),
@@ -218,11 +224,227 @@ namespace tournament
     }
     points scoreWithAcceleration(
       const Tournament &tournament,
-      decltype(matches)::size_type roundsBack = 0
+      matches_vector::size_type roundsBack = 0
     ) const;
     points acceleration(const Tournament &) const;
   };
 
+  /**
+   * The matches of all the players, stored round-major in packed columns
+   * shared by the whole tournament: the opponent IDs, and one byte per match
+   * packing the color, match score, gameWasPlayed and participatedInPairing.
+   * A round is appended for all the players at once, and the rounds past the
+   * end of a player's matches hold absences (Match(playerIndex)), so a scan
+   * over a round visits contiguous memory and needs no length checks.
+   */
+  class MatchHistory
+  {
+  public:
+    class PlayerMatches;
+
+    /**
+     * The number of rounds stored, which is at least the length of the
+     * longest list of matches.
+     */
+    round_index getRoundCount() const
+    {
+      return roundCount;
+    }
+    /**
+     * The number of players with a column, which is one more than the largest
+     * player index written so far.
+     */
+    player_index getPlayerCount() const
+    {
+      return player_index(matchCounts.size());
+    }
+
+    round_index getMatchCount(const player_index player) const
+    {
+      return player < matchCounts.size() ? matchCounts[player] : 0u;
+    }
+
+    player_index getOpponent(
+      const round_index round,
+      const player_index player
+    ) const
+    {
+      assert(round < roundCount && player < matchCounts.size());
+      return opponents[round * playerCapacity + player];
+    }
+    bool getGameWasPlayed(
+      const round_index round,
+      const player_index player
+    ) const
+    {
+      return getFlags(round, player) >> gameWasPlayedShift & 1u;
+    }
+    bool getParticipatedInPairing(
+      const round_index round,
+      const player_index player
+    ) const
+    {
+      return getFlags(round, player) >> participatedShift & 1u;
+    }
+    Match getMatch(const round_index round, const player_index player) const
+    {
+      const std::uint_least8_t matchFlags = getFlags(round, player);
+      return
+        Match(
+          getOpponent(round, player),
+          Color(matchFlags & fieldMask),
+          MatchScore(matchFlags >> matchScoreShift & fieldMask),
+          matchFlags >> gameWasPlayedShift & 1u,
+          matchFlags >> participatedShift & 1u);
+    }
+
+    PlayerMatches operator[](player_index) const &;
+
+    void push_back(player_index, const Match &) &;
+    void resize(player_index, round_index) &;
+    void clear(const player_index player) &
+    {
+      resize(player, 0u);
+    }
+
+  private:
+    static constexpr unsigned int matchScoreShift = 2u;
+    static constexpr unsigned int gameWasPlayedShift = 4u;
+    static constexpr unsigned int participatedShift = 5u;
+    static constexpr unsigned int fieldMask = 3u;
+
+    /**
+     * The number of matches of each player.
+     */
+    std::vector<round_index> matchCounts;
+    round_index roundCount{ };
+    /**
+     * The stride between rounds in opponents and flags, which is at least the
+     * number of players, and grows geometrically as players are added.
+     */
+    std::size_t playerCapacity{ };
+    /**
+     * The opponents, indexed by round * playerCapacity + player.
+     */
+    std::vector<player_index> opponents;
+    /**
+     * The color, match score, gameWasPlayed and participatedInPairing of each
+     * Match, indexed like opponents.
+     */
+    std::vector<std::uint_least8_t> flags;
+
+    std::uint_least8_t getFlags(
+      const round_index round,
+      const player_index player
+    ) const
+    {
+      assert(round < roundCount && player < matchCounts.size());
+      return flags[round * playerCapacity + player];
+    }
+    void set(round_index, player_index, const Match &) &;
+    void addPlayer(player_index) &;
+  };
+
+  /**
+   * A view of the matches of a single player, indexed by round.
+   */
+  class MatchHistory::PlayerMatches
+  {
+  public:
+    /**
+     * An iterator over the matches, which are read by value.
+     */
+    class const_iterator
+    {
+    public:
+      typedef std::ptrdiff_t difference_type;
+      typedef Match value_type;
+      typedef void pointer;
+      typedef Match reference;
+      typedef std::forward_iterator_tag iterator_category;
+
+      const_iterator() = default;
+      const_iterator(
+          const MatchHistory &history_,
+          const player_index player_,
+          const round_index round_)
+        : history(&history_), player(player_), round(round_) { }
+
+      bool operator==(const const_iterator that) const
+      {
+        return round == that.round;
+      }
+      bool operator!=(const const_iterator that) const
+      {
+        return round != that.round;
+      }
+
+      Match operator*() const
+      {
+        return history->getMatch(round, player);
+      }
+
+      const_iterator &operator++() &
+      {
+        ++round;
+        return *this;
+      }
+      const_iterator operator++(int) &
+      {
+        const_iterator result = *this;
+        ++round;
+        return result;
+      }
+
+    private:
+      const MatchHistory *history{ };
+      player_index player{ };
+      round_index round{ };
+    };
+
+    PlayerMatches(const MatchHistory &history_, const player_index player_)
+      : history(&history_), player(player_) { }
+
+    round_index size() const
+    {
+      return history->getMatchCount(player);
+    }
+    bool empty() const
+    {
+      return !size();
+    }
+
+    Match operator[](const round_index round) const
+    {
+      assert(round < size());
+      return history->getMatch(round, player);
+    }
+    Match back() const
+    {
+      return (*this)[size() - 1u];
+    }
+
+    const_iterator begin() const
+    {
+      return const_iterator(*history, player, 0u);
+    }
+    const_iterator end() const
+    {
+      return const_iterator(*history, player, size());
+    }
+
+  private:
+    const MatchHistory *history;
+    player_index player;
+  };
+
+  inline MatchHistory::PlayerMatches MatchHistory::operator[](
+    const player_index player
+  ) const &
+  {
+    return PlayerMatches(*this, player);
+  }
+
   /**
    * Compare the players based on current score, breaking ties using the
    * rankIndex.
@@ -306,6 +528,10 @@ namespace tournament
     swisssystems::SwissSystem swissSystem = swisssystems::NONE;
     bool defaultAcceleration = true;
     std::deque<ForbiddenPairsEntry> forbiddenPairs;
+    /**
+     * The matches of the players, indexed by player ID and round.
+     */
+    MatchHistory matchHistory;
 
     points getPoints(const Player &player, const Match &match) const &
     {
@@ -321,8 +547,7 @@ namespace tournament
           : pointsForDraw;
     }
 
-    std::vector<std::unordered_set<player_index>>
-      resolveForbiddenPairs(round_index) const &;
+    utility::bitmatrix::BitMatrix resolveForbiddenPairs(round_index) const &;
 
     void updateRanks() &;
     void computePlayerData() &;
@@ -334,17 +559,14 @@ namespace tournament
    */
   inline points Player::scoreWithAcceleration(
     const Tournament &tournament,
-    decltype(matches)::size_type roundsBack
+    matches_vector::size_type roundsBack
   ) const
   {
-    points score = this->scoreWithoutAcceleration;
-    round_index roundIndex = tournament.playedRounds;
-    while (roundsBack > 0u)
-    {
-      --roundIndex;
-      score -= tournament.getPoints(*this, matches[roundIndex]);
-      --roundsBack;
-    }
+    assert(roundsBack <= tournament.playedRounds);
+    const round_index roundIndex = tournament.playedRounds - roundsBack;
+    assert(!roundsBack || roundIndex < scoreHistory.size());
+    const points score =
+      roundsBack ? scoreHistory[roundIndex] : this->scoreWithoutAcceleration;
 
     const points result =
       score
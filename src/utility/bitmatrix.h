@@ -0,0 +1,65 @@
+#ifndef BITMATRIX_H
+#define BITMATRIX_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace utility
+{
+  namespace bitmatrix
+  {
+    /**
+     * A square matrix of bits, stored densely with each row padded to a whole
+     * number of words, so that a lookup is a single indexed load.
+     */
+    class BitMatrix
+    {
+    public:
+      typedef std::size_t size_type;
+
+      explicit BitMatrix(const size_type size_ = 0u)
+        : size(size_), rowWords(size_ / wordBits + !!(size_ % wordBits))
+      {
+        if (rowWords && size > std::numeric_limits<size_type>::max() / rowWords)
+        {
+          throw std::length_error("");
+        }
+        words.resize(size * rowWords);
+      }
+
+      size_type getSize() const
+      {
+        return size;
+      }
+
+      bool test(const size_type row, const size_type column) const
+      {
+        assert(row < size && column < size);
+        return
+          words[row * rowWords + column / wordBits] >> column % wordBits & 1u;
+      }
+
+      void set(const size_type row, const size_type column) &
+      {
+        assert(row < size && column < size);
+        words[row * rowWords + column / wordBits] |=
+          word{ 1u } << column % wordBits;
+      }
+
+    private:
+      typedef std::uint_least64_t word;
+      static constexpr size_type wordBits =
+        std::numeric_limits<word>::digits;
+
+      size_type size;
+      size_type rowWords;
+      std::vector<word> words;
+    };
+  }
+}
+
+#endif
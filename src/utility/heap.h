@@ -0,0 +1,164 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace utility
+{
+  namespace heap
+  {
+    /**
+     * A d-ary min-heap of references to objects that store their own position
+     * in the heap, so that an element can be removed, or moved after its key
+     * changes, in logarithmic time.
+     *
+     * Traits must provide the static member functions
+     * bool less(const T &, const T &) and std::size_t &position(T &). An object
+     * that is not in any heap must have position npos. An object can be in
+     * multiple heaps only if their Traits use different positions.
+     */
+    template <class T, class Traits, std::size_t arity = 4u>
+    class AddressableHeap
+    {
+    public:
+      static_assert(arity >= 2u, "A heap needs at least two children.");
+
+      static constexpr std::size_t npos =
+        std::numeric_limits<std::size_t>::max();
+
+      bool empty() const
+      {
+        return elements.empty();
+      }
+      T &top() const
+      {
+        assert(!elements.empty());
+        return *elements.front();
+      }
+      static bool contains(T &value)
+      {
+        return Traits::position(value) != npos;
+      }
+
+      /**
+       * Add value, which must not be in the heap.
+       */
+      void push(T &value) &
+      {
+        assert(!contains(value));
+        Traits::position(value) = elements.size();
+        elements.push_back(&value);
+        siftUp(elements.size() - 1u);
+      }
+      /**
+       * Remove value, which must be in the heap.
+       */
+      void erase(T &value) &
+      {
+        std::size_t &position = Traits::position(value);
+        assert(position < elements.size() && elements[position] == &value);
+        const std::size_t index = position;
+        position = npos;
+        T *const last = elements.back();
+        elements.pop_back();
+        if (last != &value)
+        {
+          place(last, index);
+          siftDown(siftUp(index));
+        }
+      }
+      /**
+       * Restore the heap order after the key of value changed, if value is in
+       * the heap.
+       */
+      void update(T &value) &
+      {
+        if (contains(value))
+        {
+          siftDown(siftUp(Traits::position(value)));
+        }
+      }
+      /**
+       * Remove all the elements. They must all still exist.
+       */
+      void clear() &
+      {
+        for (T *const element : elements)
+        {
+          Traits::position(*element) = npos;
+        }
+        elements.clear();
+      }
+
+    private:
+      std::vector<T *> elements;
+
+      void place(T *const element, const std::size_t index) &
+      {
+        elements[index] = element;
+        Traits::position(*element) = index;
+      }
+
+      /**
+       * Move the element at index toward the root until its parent is not
+       * greater, and return its new index.
+       */
+      std::size_t siftUp(std::size_t index) &
+      {
+        T *const element = elements[index];
+        while (index)
+        {
+          const std::size_t parent = (index - 1u) / arity;
+          if (!Traits::less(*element, *elements[parent]))
+          {
+            break;
+          }
+          place(elements[parent], index);
+          index = parent;
+        }
+        place(element, index);
+        return index;
+      }
+
+      /**
+       * Move the element at index away from the root until none of its
+       * children are less.
+       */
+      void siftDown(std::size_t index) &
+      {
+        T *const element = elements[index];
+        while (true)
+        {
+          const std::size_t firstChild = index * arity + 1u;
+          if (firstChild >= elements.size())
+          {
+            break;
+          }
+          const std::size_t endChild =
+            std::min(firstChild + arity, elements.size());
+          std::size_t minChild = firstChild;
+          for (std::size_t child = firstChild + 1u; child < endChild; ++child)
+          {
+            if (Traits::less(*elements[child], *elements[minChild]))
+            {
+              minChild = child;
+            }
+          }
+          if (!Traits::less(*elements[minChild], *element))
+          {
+            break;
+          }
+          place(elements[minChild], index);
+          index = minChild;
+        }
+        place(element, index);
+      }
+    };
+  }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef MEMORY_H
 #define MEMORY_H
 
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
 #include <limits>
@@ -48,6 +49,8 @@ namespace utility
 
       void destroy(T &) &;
 
+      std::size_t getAllocatedBytes() const;
+
     private:
       /**
        * A vector containing for each memory slot a pointer to the next slot in
@@ -182,6 +185,15 @@ namespace utility
       }
     }
 
+    /**
+     * Return the number of bytes allocated for the slots and their links.
+     */
+    template <class T>
+    inline std::size_t IterablePool<T>::getAllocatedBytes() const
+    {
+      return forwardLinks.size() * (sizeof(T) + 2u * sizeof(T *));
+    }
+
     /**
      * Destroy all existing objects and deallocate the memory.
      */
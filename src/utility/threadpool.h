@@ -0,0 +1,245 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utility
+{
+  namespace threadpool
+  {
+    /**
+     * A fixed set of threads that run batches of independent tasks. The
+     * thread calling run() takes part in the batch, so a ThreadPool of size n
+     * starts n - 1 threads.
+     *
+     * The tasks are handed out in no particular order, so a caller that needs
+     * deterministic results must have each task write only its own outputs,
+     * and combine them after run() returns.
+     */
+    class ThreadPool
+    {
+    public:
+      /**
+       * The function called for each task, given the task index and the index
+       * of the thread running it, which is less than size().
+       */
+      typedef std::function<void(std::size_t, std::size_t)> task_function;
+
+      explicit ThreadPool(const std::size_t threadCount)
+      {
+        try
+        {
+          for (std::size_t thread = 1u; thread < threadCount; ++thread)
+          {
+            workers.emplace_back([this, thread]() { loop(thread); });
+          }
+        }
+        catch (...)
+        {
+          stop();
+          throw;
+        }
+      }
+      ThreadPool(const ThreadPool &) = delete;
+
+      ~ThreadPool()
+      {
+        stop();
+      }
+
+      std::size_t size() const
+      {
+        return workers.size() + 1u;
+      }
+
+      /**
+       * Call task for each index less than taskCount, and return once all the
+       * calls have finished. If any call throws, one of the exceptions is
+       * rethrown after the rest of the batch finishes.
+       */
+      void run(const std::size_t taskCount, const task_function &task) &
+      {
+        if (workers.empty() || taskCount <= 1u)
+        {
+          for (std::size_t index{ }; index < taskCount; ++index)
+          {
+            task(index, 0u);
+          }
+          return;
+        }
+
+        {
+          const std::lock_guard<std::mutex> lock(mutex);
+          currentTask = &task;
+          currentTaskCount = taskCount;
+          nextTask.store(0u, std::memory_order_relaxed);
+          busyWorkers = workers.size();
+          ++generation;
+        }
+        workAvailable.notify_all();
+        work(0u);
+
+        std::exception_ptr thrown;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          workFinished.wait(lock, [this]() { return !busyWorkers; });
+          currentTask = nullptr;
+          thrown = std::move(exception);
+          exception = nullptr;
+        }
+        if (thrown)
+        {
+          std::rethrow_exception(thrown);
+        }
+      }
+
+    private:
+      std::vector<std::thread> workers;
+
+      std::mutex mutex;
+      std::condition_variable workAvailable;
+      std::condition_variable workFinished;
+
+      const task_function *currentTask{ };
+      std::size_t currentTaskCount{ };
+      std::atomic<std::size_t> nextTask{ };
+      std::size_t busyWorkers{ };
+      std::uint_least64_t generation{ };
+      bool stopping{ };
+      std::exception_ptr exception;
+
+      /**
+       * Run tasks from the current batch until there are none left.
+       */
+      void work(const std::size_t thread) &
+      {
+        for (
+          std::size_t index = nextTask.fetch_add(1u, std::memory_order_relaxed);
+          index < currentTaskCount;
+          index = nextTask.fetch_add(1u, std::memory_order_relaxed))
+        {
+          try
+          {
+            (*currentTask)(index, thread);
+          }
+          catch (...)
+          {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (!exception)
+            {
+              exception = std::current_exception();
+            }
+          }
+        }
+      }
+
+      void loop(const std::size_t thread) &
+      {
+        std::uint_least64_t seenGeneration{ };
+        while (true)
+        {
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            workAvailable.wait(
+              lock,
+              [this, seenGeneration]()
+              {
+                return stopping || generation != seenGeneration;
+              });
+            if (stopping)
+            {
+              return;
+            }
+            seenGeneration = generation;
+          }
+          work(thread);
+          {
+            const std::lock_guard<std::mutex> lock(mutex);
+            if (!--busyWorkers)
+            {
+              workFinished.notify_one();
+            }
+          }
+        }
+      }
+
+      void stop() &
+      {
+        {
+          const std::lock_guard<std::mutex> lock(mutex);
+          stopping = true;
+        }
+        workAvailable.notify_all();
+        for (std::thread &worker : workers)
+        {
+          worker.join();
+        }
+        workers.clear();
+      }
+    };
+
+    /**
+     * Sort the range like std::sort, sorting one slice per thread of pool and
+     * then merging the slices pairwise. If no two elements are equivalent
+     * under compare, the result does not depend on the number of threads.
+     */
+    template <typename RandomAccessIterator, typename Compare>
+    void sort(
+      ThreadPool &pool,
+      const RandomAccessIterator begin,
+      const RandomAccessIterator end,
+      const Compare &compare)
+    {
+      const std::size_t size = end - begin;
+      const std::size_t sliceCount = std::min(pool.size(), size);
+      if (sliceCount <= 1u)
+      {
+        std::sort(begin, end, compare);
+        return;
+      }
+      const auto sliceBegin =
+        [begin, size, sliceCount](const std::size_t slice)
+        {
+          return begin + size * slice / sliceCount;
+        };
+
+      pool.run(
+        sliceCount,
+        [&sliceBegin, &compare](const std::size_t slice, std::size_t)
+        {
+          std::sort(sliceBegin(slice), sliceBegin(slice + 1u), compare);
+        });
+      for (std::size_t width = 1u; width < sliceCount; width *= 2u)
+      {
+        pool.run(
+          (sliceCount - 1u) / (width * 2u) + 1u,
+          [&sliceBegin, &compare, sliceCount, width](
+            const std::size_t task,
+            std::size_t)
+          {
+            const std::size_t first = task * width * 2u;
+            const std::size_t middle = first + width;
+            if (middle < sliceCount)
+            {
+              std::inplace_merge(
+                sliceBegin(first),
+                sliceBegin(middle),
+                sliceBegin(std::min(middle + width, sliceCount)),
+                compare);
+            }
+          });
+      }
+    }
+  }
+}
+
+#endif
@@ -47,6 +47,73 @@ namespace utility
 
         struct floating_tag { };
         struct integer_tag { };
+
+        /**
+         * Whether the arithmetic of uint uses the carry builtins and, for two
+         * pieces, unsigned __int128. Defining UINT_GENERIC_ARITHMETIC selects
+         * the portable piece-by-piece loops instead, for comparison.
+         */
+#ifdef UINT_GENERIC_ARITHMETIC
+        constexpr bool specializedArithmetic = false;
+#else
+        constexpr bool specializedArithmetic = true;
+#endif
+
+        /**
+         * A native type holding a uint<pieces>, if the compiler has one.
+         */
+        template <std::size_t pieces>
+        struct wide_uint
+        {
+          static constexpr bool enabled = false;
+        };
+#ifdef __SIZEOF_INT128__
+        template <>
+        struct wide_uint<2u>
+        {
+          static constexpr bool enabled =
+            specializedArithmetic
+              && std::numeric_limits<std::uintmax_t>::digits == 64;
+          __extension__ typedef unsigned __int128 type;
+        };
+#endif
+
+        /**
+         * Return augend + addend + carry, and set carry to whether the sum
+         * overflowed.
+         */
+        constexpr std::uintmax_t addWithCarry(
+          const std::uintmax_t augend,
+          const std::uintmax_t addend,
+          bool &carry)
+        {
+          std::uintmax_t sum{ };
+          const bool overflow0 = __builtin_add_overflow(augend, addend, &sum);
+          const bool overflow1 =
+            __builtin_add_overflow(sum, std::uintmax_t{ carry }, &sum);
+          carry = overflow0 | overflow1;
+          return sum;
+        }
+        /**
+         * Return minuend - subtrahend - borrow, and set borrow to whether the
+         * difference underflowed.
+         */
+        constexpr std::uintmax_t subtractWithBorrow(
+          const std::uintmax_t minuend,
+          const std::uintmax_t subtrahend,
+          bool &borrow)
+        {
+          std::uintmax_t difference{ };
+          const bool overflow0 =
+            __builtin_sub_overflow(minuend, subtrahend, &difference);
+          const bool overflow1 =
+            __builtin_sub_overflow(
+              difference,
+              std::uintmax_t{ borrow },
+              &difference);
+          borrow = overflow0 | overflow1;
+          return difference;
+        }
       }
     }
 
@@ -54,6 +121,11 @@ namespace utility
      * A type for fixed-size unsigned integers larger than std::uintmax_t. The
      * data is stored in std::uintmax_t fields, with the template parameter
      * indicating the number of such fields.
+     *
+     * The template is recursive, so the operations on the pieces are unrolled
+     * at compile time. Additions and subtractions propagate the carries
+     * without branches, and two-piece values use unsigned __int128 where the
+     * compiler supports it.
      */
     template <std::size_t pieces>
     class uint
@@ -94,15 +166,20 @@ namespace utility
       }
       constexpr bool operator<(const uint<pieces> that) const
       {
-        return
-          std::tie(highPiece, lowPieces)
-            < std::tie(that.highPiece, that.lowPieces);
+        if constexpr (detail::wide_uint<pieces>::enabled)
+        {
+          return toWide() < that.toWide();
+        }
+        else
+        {
+          return
+            std::tie(highPiece, lowPieces)
+              < std::tie(that.highPiece, that.lowPieces);
+        }
       }
       constexpr bool operator>(const uint<pieces> that) const
       {
-        return
-          std::tie(highPiece, lowPieces)
-            > std::tie(that.highPiece, that.lowPieces);
+        return that < *this;
       }
       constexpr bool operator!=(const uint<pieces> that) const
       {
@@ -110,15 +187,11 @@ namespace utility
       }
       constexpr bool operator<=(const uint<pieces> that) const
       {
-        return
-          std::tie(highPiece, lowPieces)
-            <= std::tie(that.highPiece, that.lowPieces);
+        return !(that < *this);
       }
       constexpr bool operator>=(const uint<pieces> that) const
       {
-        return
-          std::tie(highPiece, lowPieces)
-            >= std::tie(that.highPiece, that.lowPieces);
+        return !(*this < that);
       }
 
       constexpr uint<pieces> operator~() const
@@ -194,7 +267,14 @@ namespace utility
       {
         constexpr unsigned int unsafeShift =
           std::numeric_limits<std::uintmax_t>::digits;
-        if (shift >= unsafeShift)
+        if constexpr (detail::wide_uint<pieces>::enabled)
+        {
+          *this =
+            shift >= unsafeShift * pieces
+              ? uint<pieces>{ }
+              : fromWide(toWide() << shift);
+        }
+        else if (shift >= unsafeShift)
         {
           highPiece = lowPieces.highPiece;
           lowPieces <<= unsafeShift;
@@ -213,7 +293,14 @@ namespace utility
       {
         constexpr unsigned int unsafeShift =
           std::numeric_limits<std::uintmax_t>::digits;
-        if (shift >= unsafeShift)
+        if constexpr (detail::wide_uint<pieces>::enabled)
+        {
+          *this =
+            shift >= unsafeShift * pieces
+              ? uint<pieces>{ }
+              : fromWide(toWide() >> shift);
+        }
+        else if (shift >= unsafeShift)
         {
           lowPieces >>= unsafeShift;
           lowPieces.highPiece = highPiece;
@@ -247,7 +334,14 @@ namespace utility
       }
       constexpr uint<pieces> &operator-=(const uint<pieces> that) &
       {
-        *this += -that;
+        if constexpr (detail::specializedArithmetic)
+        {
+          subtractBorrow(that);
+        }
+        else
+        {
+          *this += -that;
+        }
         return *this;
       }
       constexpr uint<pieces> &operator*=(const uint<pieces> that) &
@@ -290,6 +384,31 @@ namespace utility
         return result;
       }
 
+      /**
+       * Add addend and subtract subtrahend, in a single pass over the pieces.
+       */
+      constexpr uint<pieces> &addSubtract(
+        const uint<pieces> addend,
+        const uint<pieces> subtrahend) &
+      {
+        if constexpr (detail::wide_uint<pieces>::enabled)
+        {
+          *this = fromWide(toWide() + addend.toWide() - subtrahend.toWide());
+        }
+        else if constexpr (detail::specializedArithmetic)
+        {
+          bool carry{ };
+          bool borrow{ };
+          addSubtract(addend, subtrahend, carry, borrow);
+        }
+        else
+        {
+          *this += addend;
+          *this -= subtrahend;
+        }
+        return *this;
+      }
+
       template <
         typename T,
         typename = typename std::enable_if<std::is_arithmetic<T>::value>::type>
@@ -362,13 +481,81 @@ namespace utility
         }
       }
 
+      constexpr auto toWide() const
+      {
+        typedef typename detail::wide_uint<pieces>::type wide_type;
+        return
+          wide_type{ highPiece } << std::numeric_limits<std::uintmax_t>::digits
+            | wide_type{ lowPieces.highPiece };
+      }
+      template <typename wide_type>
+      static constexpr uint<pieces> fromWide(const wide_type value)
+      {
+        return
+          uint<pieces>(
+            uint<pieces - 1>(std::uintmax_t(value)),
+            std::uintmax_t(
+              value >> std::numeric_limits<std::uintmax_t>::digits));
+      }
+
       constexpr bool addCarry(const uint<pieces> that) &
       {
-        const bool lowCarry = lowPieces.addCarry(that.lowPieces);
-        highPiece += that.highPiece;
-        const bool highCarry = highPiece < that.highPiece;
-        highPiece += lowCarry;
-        return highPiece < lowCarry || highCarry;
+        if constexpr (detail::wide_uint<pieces>::enabled)
+        {
+          const auto sum = toWide() + that.toWide();
+          const bool carry = sum < that.toWide();
+          *this = fromWide(sum);
+          return carry;
+        }
+        else if constexpr (detail::specializedArithmetic)
+        {
+          bool carry = lowPieces.addCarry(that.lowPieces);
+          highPiece = detail::addWithCarry(highPiece, that.highPiece, carry);
+          return carry;
+        }
+        else
+        {
+          const bool lowCarry = lowPieces.addCarry(that.lowPieces);
+          highPiece += that.highPiece;
+          const bool highCarry = highPiece < that.highPiece;
+          highPiece += lowCarry;
+          return highPiece < lowCarry || highCarry;
+        }
+      }
+      constexpr bool subtractBorrow(const uint<pieces> that) &
+      {
+        if constexpr (detail::wide_uint<pieces>::enabled)
+        {
+          const bool borrow = *this < that;
+          *this = fromWide(toWide() - that.toWide());
+          return borrow;
+        }
+        else
+        {
+          bool borrow = lowPieces.subtractBorrow(that.lowPieces);
+          highPiece =
+            detail::subtractWithBorrow(highPiece, that.highPiece, borrow);
+          return borrow;
+        }
+      }
+      /**
+       * Add addend and subtract subtrahend, taking in and passing on the carry
+       * of the addition and the borrow of the subtraction.
+       */
+      constexpr void addSubtract(
+        const uint<pieces> addend,
+        const uint<pieces> subtrahend,
+        bool &carry,
+        bool &borrow) &
+      {
+        lowPieces.addSubtract(
+          addend.lowPieces,
+          subtrahend.lowPieces,
+          carry,
+          borrow);
+        highPiece = detail::addWithCarry(highPiece, addend.highPiece, carry);
+        highPiece =
+          detail::subtractWithBorrow(highPiece, subtrahend.highPiece, borrow);
       }
       constexpr uint<pieces> lowHalves() const
       {
@@ -599,6 +786,15 @@ namespace utility
         return highPiece--;
       }
 
+      constexpr uint<1> &addSubtract(
+        const uint<1> addend,
+        const uint<1> subtrahend) &
+      {
+        highPiece += addend.highPiece;
+        highPiece -= subtrahend.highPiece;
+        return *this;
+      }
+
       template <typename T>
       explicit constexpr operator T() const
       {
@@ -613,6 +809,22 @@ namespace utility
         highPiece += that.highPiece;
         return highPiece < that.highPiece;
       }
+      constexpr bool subtractBorrow(const uint<1> that) &
+      {
+        const bool borrow = highPiece < that.highPiece;
+        highPiece -= that.highPiece;
+        return borrow;
+      }
+      constexpr void addSubtract(
+        const uint<1> addend,
+        const uint<1> subtrahend,
+        bool &carry,
+        bool &borrow) &
+      {
+        highPiece = detail::addWithCarry(highPiece, addend.highPiece, carry);
+        highPiece =
+          detail::subtractWithBorrow(highPiece, subtrahend.highPiece, borrow);
+      }
       constexpr uint<1> lowHalves() const
       {
         constexpr std::size_t shift =
@@ -0,0 +1,39 @@
+
+#define TEST_ID matching_forced_updates
+#include <tests/matching_forced_updates.cpp>
+#undef TEST_ID
+#define TEST_ID matching_warm_start
+#include <tests/matching_warm_start.cpp>
+#undef TEST_ID
+#define TEST_ID dutch_moved_down_after_finalize
+#include <tests/dutch_moved_down_after_finalize.cpp>
+#undef TEST_ID
+#define TEST_ID matching_certificate
+#include <tests/matching_certificate.cpp>
+#undef TEST_ID
+#define TEST_ID dutch_2025_C5
+#include <tests/dutch_2025_C5.cpp>
+#undef TEST_ID
+#define TEST_ID dutch_2025_C9
+#include <tests/dutch_2025_C9.cpp>
+#undef TEST_ID
+#define TEST_ID issue_15
+#include <tests/issue_15.cpp>
+#undef TEST_ID
+#define TEST_ID issue_7
+#include <tests/issue_7.cpp>
+#undef TEST_ID
+
+int runTests(const testing::Context &context)
+{
+  BEFORE_RUNNING_TESTS
+  RUN_TEST(matching_forced_updates)
+  RUN_TEST(matching_warm_start)
+  RUN_TEST(dutch_moved_down_after_finalize)
+  RUN_TEST(matching_certificate)
+  RUN_TEST(dutch_2025_C5)
+  RUN_TEST(dutch_2025_C9)
+  RUN_TEST(issue_15)
+  RUN_TEST(issue_7)
+  AFTER_RUNNING_TESTS
+}
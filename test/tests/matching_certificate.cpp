@@ -0,0 +1,113 @@
+// Check that verifyDualCertificate rejects certificates that do not prove the
+// matching optimal, not just that it accepts the ones the Computer produces.
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <matching/certificate.h>
+
+void TEST_FUNCTION(const testing::Context &)
+{
+  typedef std::uint_least64_t edge_weight;
+
+  // A triangle of weight-4 edges between vertices 0, 1, and 2, and an edge of
+  // weight 1 between vertices 2 and 3. The maximum weight matching pairs 0
+  // with 1 and 2 with 3, and the triangle forms a blossom.
+  const auto edgeWeights =
+    [](const matching::detail::vertex_index vertex,
+        const matching::detail::vertex_index neighbor)
+    {
+      const matching::detail::vertex_index low =
+        vertex < neighbor ? vertex : neighbor;
+      const matching::detail::vertex_index high =
+        vertex < neighbor ? neighbor : vertex;
+      return edge_weight{ high < 3u ? 4u : low == 2u ? 1u : 0u };
+    };
+  const std::vector<matching::detail::vertex_index> matching{ 1u, 0u, 3u, 2u };
+  const matching::DualCertificate<edge_weight> certificate{
+    { 2u, 2u, 2u, 0u },
+    { 0u, 1u, 2u, 3u },
+    { { 0u, 3u, 4u } }
+  };
+
+  if (!matching::verifyDualCertificate(certificate, matching, edgeWeights))
+  {
+    throw std::runtime_error("A valid certificate was rejected.");
+  }
+
+  const auto expectRejected =
+    [&edgeWeights](
+      const matching::DualCertificate<edge_weight> &wrongCertificate,
+      const std::vector<matching::detail::vertex_index> &wrongMatching,
+      const char *const description)
+    {
+      if (
+        matching::verifyDualCertificate(
+          wrongCertificate,
+          wrongMatching,
+          edgeWeights))
+      {
+        throw std::runtime_error(
+          std::string("A certificate with ") + description + " was accepted.");
+      }
+    };
+
+  matching::DualCertificate<edge_weight> wrongCertificate = certificate;
+  wrongCertificate.vertexDualVariables[0] = 1u;
+  expectRejected(wrongCertificate, matching, "a negative slack");
+
+  wrongCertificate = certificate;
+  wrongCertificate.vertexDualVariables[3] = 2u;
+  expectRejected(wrongCertificate, matching, "a matched edge that is not tight");
+
+  wrongCertificate = certificate;
+  wrongCertificate.blossoms.front().dualVariable = 2u;
+  expectRejected(wrongCertificate, matching, "a blossom dual variable too low");
+
+  expectRejected(
+    certificate,
+    { 1u, 0u, 2u, 3u },
+    "an unmatched vertex with a positive dual variable");
+
+  expectRejected(
+    certificate,
+    { 3u, 2u, 1u, 0u },
+    "a matched edge of weight zero");
+
+  wrongCertificate = certificate;
+  wrongCertificate.vertexOrder = { 0u, 1u, 1u, 3u };
+  expectRejected(wrongCertificate, matching, "a repeated vertex");
+
+  wrongCertificate = certificate;
+  wrongCertificate.blossoms.front().end = 4u;
+  expectRejected(wrongCertificate, matching, "an even blossom");
+
+  // Add vertices 4 and 5, and pair each of 0, 1, and 2 by an edge of weight 1
+  // to one of 3, 4, and 5. Matching those edges makes every matched edge tight
+  // and no slack negative, but the blossom then holds no matched edge.
+  const auto outerEdgeWeights =
+    [](const matching::detail::vertex_index vertex,
+        const matching::detail::vertex_index neighbor)
+    {
+      const matching::detail::vertex_index low =
+        vertex < neighbor ? vertex : neighbor;
+      const matching::detail::vertex_index high =
+        vertex < neighbor ? neighbor : vertex;
+      return edge_weight{ high < 3u ? 4u : high == low + 3u ? 1u : 0u };
+    };
+  const matching::DualCertificate<edge_weight> outerCertificate{
+    { 2u, 2u, 2u, 0u, 0u, 0u },
+    { 0u, 1u, 2u, 3u, 4u, 5u },
+    { { 0u, 3u, 4u } }
+  };
+  if (
+    matching::verifyDualCertificate(
+      outerCertificate,
+      { 3u, 4u, 5u, 0u, 1u, 2u },
+      outerEdgeWeights))
+  {
+    throw std::runtime_error(
+      "A certificate with a blossom short of matched edges was accepted.");
+  }
+}
@@ -0,0 +1,272 @@
+// Check setEdgeWeightsIfMatchIsForced and isolateMatchedPair on random graphs
+// against matchings computed from scratch, covering both the updates they
+// accept and the ones they leave to computeMatching().
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <matching/computer.h>
+#include <matching/templateinstantiation.h>
+
+void TEST_FUNCTION(const testing::Context &)
+{
+  typedef swisssystems::burstein::matching_computer matching_computer;
+  typedef matching_computer::edge_weight edge_weight;
+  typedef matching_computer::vertex_index vertex_index;
+
+  constexpr vertex_index size = 9u;
+  constexpr std::uint_least32_t maxEdgeWeight = 6u;
+
+  std::minstd_rand randomEngine{ 1u };
+  const auto random =
+    [&randomEngine](const std::uint_least32_t bound)
+    {
+      return static_cast<std::uint_least32_t>(randomEngine() % bound);
+    };
+
+  // Check that the Computer holds a maximum weight matching, by comparing it
+  // with one computed from scratch, and return the matching. If forcedVertex
+  // is a vertex, every maximum weight matching must keep its match, so the one
+  // computed from scratch must too.
+  const auto checkOptimal =
+    [](
+      const matching_computer &computer,
+      const char *const step,
+      const vertex_index forcedVertex =
+        std::numeric_limits<vertex_index>::max())
+    {
+      matching_computer reference(size, maxEdgeWeight);
+      for (vertex_index vertex{ }; vertex < size; ++vertex)
+      {
+        reference.addVertex();
+        for (vertex_index neighbor{ }; neighbor < vertex; ++neighbor)
+        {
+          reference.setEdgeWeight(
+            vertex,
+            neighbor,
+            computer.getEdgeWeight(vertex, neighbor));
+        }
+      }
+      reference.computeMatching();
+
+      const std::vector<vertex_index> matching = computer.getMatching();
+      const std::vector<vertex_index> referenceMatching =
+        reference.getMatching();
+      edge_weight weight{ };
+      edge_weight referenceWeight{ };
+      for (vertex_index vertex{ }; vertex < size; ++vertex)
+      {
+        if (matching[vertex] != vertex)
+        {
+          weight += computer.getEdgeWeight(vertex, matching[vertex]);
+        }
+        if (referenceMatching[vertex] != vertex)
+        {
+          referenceWeight +=
+            computer.getEdgeWeight(vertex, referenceMatching[vertex]);
+        }
+      }
+      if (
+        weight != referenceWeight
+          || (forcedVertex < size
+                && referenceMatching[forcedVertex] != matching[forcedVertex])
+          || !matching::verifyDualCertificate(
+                computer.getDualCertificate(),
+                matching,
+                [&computer](
+                  const vertex_index vertex,
+                  const vertex_index neighbor)
+                {
+                  return computer.getEdgeWeight(vertex, neighbor);
+                }))
+      {
+        throw std::runtime_error(
+          std::string("The matching is not optimal after ") + step + ".");
+      }
+      return matching;
+    };
+
+  // Check whether the vertex is in a Blossom with more than one vertex.
+  const auto isInBlossom =
+    [](const matching_computer &computer, const vertex_index vertex)
+    {
+      const matching::DualCertificate<edge_weight> certificate =
+        computer.getDualCertificate();
+      for (const auto &blossom : certificate.blossoms)
+      {
+        for (
+          std::size_t position = blossom.begin;
+          position < blossom.end;
+          ++position)
+        {
+          if (certificate.vertexOrder[position] == vertex)
+          {
+            return true;
+          }
+        }
+      }
+      return false;
+    };
+
+  const auto getEdgeWeights =
+    [](const matching_computer &computer, const vertex_index vertex)
+    {
+      std::vector<edge_weight> result;
+      for (vertex_index neighbor{ }; neighbor < size; ++neighbor)
+      {
+        result.push_back(
+          neighbor == vertex ? 0u : computer.getEdgeWeight(vertex, neighbor));
+      }
+      return result;
+    };
+
+  unsigned int forcedAccepted{ };
+  unsigned int forcedAcceptedInBlossom{ };
+  unsigned int forcedRejected{ };
+  unsigned int isolatedAccepted{ };
+  unsigned int isolatedAcceptedInBlossom{ };
+  unsigned int isolatedRejected{ };
+  unsigned int isolatedRejectedInBlossom{ };
+
+  for (unsigned int graphIndex{ }; graphIndex < 200u; ++graphIndex)
+  {
+    // Triangles of heavy edges make Blossoms likely.
+    matching_computer computer(size, maxEdgeWeight);
+    for (vertex_index vertex{ }; vertex < size; ++vertex)
+    {
+      computer.addVertex();
+      for (vertex_index neighbor{ }; neighbor < vertex; ++neighbor)
+      {
+        computer.setEdgeWeight(
+          vertex,
+          neighbor,
+          vertex / 3u == neighbor / 3u
+            ? edge_weight{ 4u + random(3u) }
+            : edge_weight{ random(4u) });
+      }
+    }
+    computer.computeMatching();
+    std::vector<vertex_index> matching = checkOptimal(computer, "solving");
+
+    for (unsigned int step{ }; step < 6u; ++step)
+    {
+      const vertex_index vertex = static_cast<vertex_index>(random(size));
+      const vertex_index match = matching[vertex];
+      const std::vector<edge_weight> edgeWeights =
+        getEdgeWeights(computer, vertex);
+      const bool inBlossom = isInBlossom(computer, vertex);
+
+      if (random(2u))
+      {
+        // Lower the weights of the other edges at the vertex, more often than
+        // not far enough that the vertex must keep its match.
+        std::vector<vertex_index> neighbors;
+        std::vector<edge_weight> newEdgeWeights;
+        for (vertex_index neighbor{ }; neighbor < size; ++neighbor)
+        {
+          if (neighbor == vertex)
+          {
+            continue;
+          }
+          neighbors.push_back(neighbor);
+          newEdgeWeights.push_back(
+            neighbor == match
+              ? edgeWeights[neighbor]
+              : edge_weight{ random(3u) ? 0u : random(maxEdgeWeight + 1u) });
+        }
+
+        if (
+          computer.setEdgeWeightsIfMatchIsForced(
+            vertex,
+            neighbors,
+            newEdgeWeights))
+        {
+          ++forcedAccepted;
+          forcedAcceptedInBlossom += inBlossom;
+          const std::vector<vertex_index> newMatching =
+            checkOptimal(computer, "forcing a match", vertex);
+          if (match == vertex || newMatching[vertex] != match)
+          {
+            throw std::runtime_error("A forced match was not kept.");
+          }
+          matching = newMatching;
+          continue;
+        }
+        ++forcedRejected;
+        if (
+          getEdgeWeights(computer, vertex) != edgeWeights
+            || computer.getMatching() != matching)
+        {
+          throw std::runtime_error(
+            "A rejected forced match changed the graph.");
+        }
+        computer.setEdgeWeights(vertex, neighbors, newEdgeWeights);
+      }
+      else
+      {
+        const edge_weight edgeWeight{ random(maxEdgeWeight + 1u) };
+        if (computer.isolateMatchedPair(vertex, match, edgeWeight))
+        {
+          ++isolatedAccepted;
+          isolatedAcceptedInBlossom += inBlossom;
+          const std::vector<vertex_index> newMatching =
+            checkOptimal(computer, "isolating a pair");
+          if (match == vertex || newMatching[vertex] != match)
+          {
+            throw std::runtime_error("An isolated pair was not kept.");
+          }
+          for (vertex_index neighbor{ }; neighbor < size; ++neighbor)
+          {
+            if (
+              neighbor != vertex
+                && computer.getEdgeWeight(vertex, neighbor)
+                     != (neighbor == match ? edgeWeight : 0u))
+            {
+              throw std::runtime_error("An isolated pair kept other edges.");
+            }
+          }
+          matching = newMatching;
+          continue;
+        }
+        ++isolatedRejected;
+        isolatedRejectedInBlossom += inBlossom && match != vertex;
+        if (
+          getEdgeWeights(computer, vertex) != edgeWeights
+            || computer.getMatching() != matching)
+        {
+          throw std::runtime_error("A rejected isolation changed the graph.");
+        }
+        if (match != vertex)
+        {
+          for (vertex_index neighbor{ }; neighbor < size; ++neighbor)
+          {
+            if (neighbor != vertex && neighbor != match)
+            {
+              computer.setEdgeWeight(vertex, neighbor, 0u);
+              computer.setEdgeWeight(match, neighbor, 0u);
+            }
+          }
+          computer.setEdgeWeight(vertex, match, edgeWeight);
+        }
+      }
+      computer.computeMatching();
+      matching = checkOptimal(computer, "solving again");
+    }
+  }
+
+  if (
+    !forcedAccepted
+      || !forcedAcceptedInBlossom
+      || !forcedRejected
+      || !isolatedAccepted
+      || !isolatedAcceptedInBlossom
+      || !isolatedRejected
+      || !isolatedRejectedInBlossom)
+  {
+    throw std::runtime_error("The random graphs missed a case.");
+  }
+}
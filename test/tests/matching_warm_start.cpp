@@ -0,0 +1,178 @@
+// Check that a Computer warm started from a solved one, with vertices
+// reordered, dropped and added and some edge weights changed, finds a maximum
+// weight matching once the changed vertices are repaired.
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <matching/computer.h>
+#include <matching/templateinstantiation.h>
+
+void TEST_FUNCTION(const testing::Context &)
+{
+  typedef swisssystems::burstein::matching_computer matching_computer;
+  typedef matching_computer::edge_weight edge_weight;
+  typedef matching_computer::vertex_index vertex_index;
+
+  constexpr vertex_index previousSize = 10u;
+  constexpr vertex_index size = 11u;
+  constexpr std::uint_least32_t maxEdgeWeight = 6u;
+
+  std::minstd_rand randomEngine{ 1u };
+  const auto random =
+    [&randomEngine](const std::uint_least32_t bound)
+    {
+      return static_cast<std::uint_least32_t>(randomEngine() % bound);
+    };
+
+  // Return the weight of the matching computed from scratch over the weights
+  // of the Computer.
+  const auto getMaxWeight =
+    [](const matching_computer &computer)
+    {
+      matching_computer reference(computer.size(), maxEdgeWeight);
+      for (vertex_index vertex{ }; vertex < computer.size(); ++vertex)
+      {
+        reference.addVertex();
+        for (vertex_index neighbor{ }; neighbor < vertex; ++neighbor)
+        {
+          reference.setEdgeWeight(
+            vertex,
+            neighbor,
+            computer.getEdgeWeight(vertex, neighbor));
+        }
+      }
+      reference.computeMatching();
+      const std::vector<vertex_index> matching = reference.getMatching();
+      edge_weight result{ };
+      for (vertex_index vertex{ }; vertex < computer.size(); ++vertex)
+      {
+        if (matching[vertex] != vertex)
+        {
+          result += computer.getEdgeWeight(vertex, matching[vertex]);
+        }
+      }
+      return result;
+    };
+
+  unsigned int keptMatches{ };
+  for (unsigned int graphIndex{ }; graphIndex < 200u; ++graphIndex)
+  {
+    // Triangles of heavy edges make Blossoms likely.
+    matching_computer previous(previousSize, maxEdgeWeight);
+    for (vertex_index vertex{ }; vertex < previousSize; ++vertex)
+    {
+      previous.addVertex();
+      for (vertex_index neighbor{ }; neighbor < vertex; ++neighbor)
+      {
+        previous.setEdgeWeight(
+          vertex,
+          neighbor,
+          vertex / 3u == neighbor / 3u
+            ? edge_weight{ 4u + random(3u) }
+            : edge_weight{ random(4u) });
+      }
+    }
+    previous.computeMatching();
+    const std::vector<vertex_index> previousMatching = previous.getMatching();
+
+    // Drop two of the previous vertices, add three, and shuffle.
+    std::vector<vertex_index> previousVertices;
+    for (vertex_index vertex{ }; vertex < previousSize + 1u; ++vertex)
+    {
+      previousVertices.push_back(vertex);
+    }
+    std::shuffle(
+      previousVertices.begin(),
+      previousVertices.end(),
+      randomEngine);
+    previousVertices.resize(size - 3u);
+    previousVertices.insert(previousVertices.end(), 3u, previousSize);
+    std::shuffle(
+      previousVertices.begin(),
+      previousVertices.end(),
+      randomEngine);
+
+    matching_computer computer(size, maxEdgeWeight);
+    for (vertex_index vertex{ }; vertex < size; ++vertex)
+    {
+      computer.addVertex();
+    }
+    computer.warmStart(previous, previousVertices);
+
+    for (vertex_index vertex{ }; vertex < size; ++vertex)
+    {
+      for (vertex_index neighbor{ }; neighbor < vertex; ++neighbor)
+      {
+        if (
+          previousVertices[vertex] < previousSize
+            && previousVertices[neighbor] < previousSize
+            && computer.getEdgeWeight(vertex, neighbor)
+                 != previous.getEdgeWeight(
+                      previousVertices[vertex],
+                      previousVertices[neighbor]))
+        {
+          throw std::runtime_error("An edge weight was not copied.");
+        }
+      }
+    }
+
+    // Give the new vertices weights, and change those of a few retained
+    // vertices.
+    for (vertex_index vertex{ }; vertex < size; ++vertex)
+    {
+      if (previousVertices[vertex] < previousSize && random(4u))
+      {
+        continue;
+      }
+      std::vector<vertex_index> neighbors;
+      std::vector<edge_weight> edgeWeights;
+      for (vertex_index neighbor{ }; neighbor < size; ++neighbor)
+      {
+        if (neighbor != vertex)
+        {
+          neighbors.push_back(neighbor);
+          edgeWeights.push_back(random(maxEdgeWeight + 1u));
+        }
+      }
+      computer.setEdgeWeights(vertex, neighbors, edgeWeights);
+    }
+
+    computer.computeMatching();
+    const std::vector<vertex_index> matching = computer.getMatching();
+    edge_weight weight{ };
+    for (vertex_index vertex{ }; vertex < size; ++vertex)
+    {
+      if (matching[vertex] != vertex)
+      {
+        weight += computer.getEdgeWeight(vertex, matching[vertex]);
+        keptMatches +=
+          previousVertices[vertex] < previousSize
+            && previousVertices[matching[vertex]] < previousSize
+            && previousMatching[previousVertices[vertex]]
+                 == previousVertices[matching[vertex]];
+      }
+    }
+    if (
+      weight != getMaxWeight(computer)
+        || !matching::verifyDualCertificate(
+              computer.getDualCertificate(),
+              matching,
+              [&computer](
+                const vertex_index vertex,
+                const vertex_index neighbor)
+              {
+                return computer.getEdgeWeight(vertex, neighbor);
+              }))
+    {
+      throw std::runtime_error("The warm started matching is not optimal.");
+    }
+  }
+
+  if (!keptMatches)
+  {
+    throw std::runtime_error("No match was carried over.");
+  }
+}